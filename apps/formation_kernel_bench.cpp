@@ -0,0 +1,175 @@
+// Micro-benchmark: formation-force evaluation per drone, legacy per-neighbor Vector3D
+// loop vs. the batched kernel (scalar and AVX2), and a whole-swarm batch call.
+//
+//   formation_kernel_bench [--iterations=N] [--drones=N] [--seed=N]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common/vector3D.h"
+#include "modules/controller/formation_kernel.h"
+
+struct CliArgs {
+  int iterations = 200000;  // per-drone evaluations per size
+  int drones = 64;          // queries per batch call
+  int seed = 1;
+};
+
+bool TryGetArgValue(const std::vector<std::string>& args, const std::string& key, std::string* value) {
+  const std::string prefix = key + "=";
+  for (size_t i = 0; i < args.size(); ++i) {
+    if (args[i].rfind(prefix, 0) == 0) {
+      *value = args[i].substr(prefix.size());
+      return true;
+    }
+  }
+  return false;
+}
+
+void ParseCli(int argc, char* argv[], CliArgs* out) {
+  std::vector<std::string> args(argv, argv + argc);
+  auto parseInt = [&](const std::string& key, int* dst) {
+    std::string value;
+    if (TryGetArgValue(args, key, &value)) {
+      *dst = std::max(1, std::stoi(value));
+    }
+  };
+  parseInt("--iterations", &out->iterations);
+  parseInt("--drones", &out->drones);
+  parseInt("--seed", &out->seed);
+}
+
+struct NeighborTable {
+  std::vector<uint8_t> ids;
+  std::vector<double> x;
+  std::vector<double> y;
+  std::vector<double> z;
+  std::vector<uint8_t> hops;
+
+  NeighborSpan span() const { return NeighborSpan{ids, x, y, z, hops}; }
+};
+
+// Neighbors scattered around the origin, a few of them inside D_safe.
+NeighborTable MakeNeighbors(size_t count, std::mt19937& rng) {
+  std::uniform_real_distribution<double> coord(-6.0, 6.0);
+  std::uniform_int_distribution<int> hop(1, 4);
+  NeighborTable table;
+  for (size_t i = 0; i < count; ++i) {
+    table.ids.push_back(static_cast<uint8_t>(i));
+    table.x.push_back(coord(rng));
+    table.y.push_back(coord(rng));
+    table.z.push_back(coord(rng) * 0.25);
+    table.hops.push_back(static_cast<uint8_t>(hop(rng)));
+  }
+  return table;
+}
+
+// The pre-kernel Controller::step loop, kept as the baseline.
+Vector3D LegacyForce(const FormationForceParams& params, Vector3D self, uint8_t self_hops, const NeighborSpan& neighbors) {
+  const float k_att = static_cast<float>(params.k_att);
+  const float k_rep = static_cast<float>(params.k_rep);
+  const float d_safe = static_cast<float>(params.d_safe);
+  Vector3D force{0.0f, 0.0f, 0.0f};
+  for (size_t i = 0; i < neighbors.size(); ++i) {
+    const uint8_t neighbor_hops = neighbors.hops[i];
+    Vector3D diff(neighbors.x[i] - self.x, neighbors.y[i] - self.y, neighbors.z[i] - self.z);
+    if (neighbor_hops < self_hops || neighbor_hops > self_hops) {
+      force = force + (k_att * diff);
+    }
+    if (diff.module() < d_safe) {
+      float distance = diff.module();
+      if (distance == 0) {
+        continue;
+      }
+      force = force - (k_rep / std::pow(distance, 2)) * diff.unit_vector();
+    }
+  }
+  return force;
+}
+
+template <typename Fn>
+double NanosPerCall(int iterations, Fn&& fn) {
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    fn(i);
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  return std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+}
+
+double MaxError(const Vector3D& a, const Vector3D& b) {
+  return std::max({std::fabs(a.x - b.x), std::fabs(a.y - b.y), std::fabs(a.z - b.z)});
+}
+
+int main(int argc, char* argv[]) {
+  CliArgs args;
+  ParseCli(argc, argv, &args);
+
+  const FormationForceParams params{1.0, 5.0, 2.0};
+  const bool avx2 = formationKernelHasAvx2();
+  std::mt19937 rng(static_cast<uint32_t>(args.seed));
+
+  std::cout << "[Bench] avx2=" << (avx2 ? 1 : 0)
+    << " iterations=" << args.iterations
+    << " drones=" << args.drones << "\n";
+
+  for (size_t count : {size_t{8}, size_t{64}, size_t{512}}) {
+    const NeighborTable table = MakeNeighbors(count, rng);
+    const NeighborSpan neighbors = table.span();
+
+    // Vary the querying drone a little so the compiler cannot hoist the work.
+    std::vector<Vector3D> selves;
+    for (int i = 0; i < 64; ++i) {
+      selves.emplace_back(0.01 * i, -0.01 * i, 0.0);
+    }
+    auto self = [&](int i) { return selves[static_cast<size_t>(i) & 63]; };
+
+    Vector3D sink{0.0, 0.0, 0.0};
+    const double legacy_ns = NanosPerCall(args.iterations, [&](int i) {
+      sink = sink + LegacyForce(params, self(i), 2, neighbors);
+    });
+    const double scalar_ns = NanosPerCall(args.iterations, [&](int i) {
+      sink = sink + formationForceScalar(params, self(i), 2, neighbors);
+    });
+    double avx2_ns = 0.0;
+    if (avx2) {
+      avx2_ns = NanosPerCall(args.iterations, [&](int i) {
+        sink = sink + formationForceAvx2(params, self(i), 2, neighbors);
+      });
+    }
+
+    // One call for the whole swarm, every drone seeing the same neighbor table.
+    std::vector<FormationForceQuery> queries;
+    for (int d = 0; d < args.drones; ++d) {
+      queries.push_back(FormationForceQuery{self(d), static_cast<uint8_t>(1 + d % 4), neighbors});
+    }
+    std::vector<Vector3D> forces(queries.size());
+    const int batch_calls = std::max(1, args.iterations / args.drones);
+    const double batch_ns = NanosPerCall(batch_calls, [&](int) {
+      computeFormationForces(params, queries, forces);
+      sink = sink + forces[0];
+    }) / args.drones;
+
+    const Vector3D reference = LegacyForce(params, self(0), 2, neighbors);
+    double error = MaxError(reference, formationForceScalar(params, self(0), 2, neighbors));
+    if (avx2) {
+      error = std::max(error, MaxError(reference, formationForceAvx2(params, self(0), 2, neighbors)));
+    }
+
+    std::cout << "[Bench] neighbors=" << count
+      << " legacy_ns=" << legacy_ns
+      << " scalar_ns=" << scalar_ns
+      << " avx2_ns=" << avx2_ns
+      << " batch_ns_per_drone=" << batch_ns
+      << " speedup=" << legacy_ns / (avx2 ? avx2_ns : scalar_ns)
+      << " max_abs_error=" << error
+      << " (sink=" << sink.module() << ")\n";
+  }
+  return 0;
+}
@@ -1,7 +1,8 @@
+#include <algorithm>
 #include <cstdint>
+#include <cstdio>
 #include <iostream>
 #include <memory>
-#include <fstream>
 #include <vector>
 
 #include "ns3/core-module.h"
@@ -9,18 +10,22 @@
 #include "ns3/network-module.h"
 #include "ns3/netanim-module.h"
 
+#include "common/packet_payload.h"
+#include "modules/logging/event_log.h"
+#include "modules/logging/trajectory_trace.h"
 #include "platform/ns3/base_station/ns3_base_station.h"
 #include "platform/ns3/drone/ns3_drone.h"
 #include "platform/ns3/radio_environment/radio_environment.h"
+#include "platform/ns3/swarm/ns3_swarm.h"
 
 using namespace ns3;
 
 namespace {
 
 void EnsureMobility(Ptr<Node> node, const Vector& pos) {
-  auto mob = node->GetObject<ConstantPositionMobilityModel>();
+  auto mob = node->GetObject<KinematicMobilityModel>();
   if (!mob) {
-    mob = CreateObject<ConstantPositionMobilityModel>();
+    mob = CreateObject<KinematicMobilityModel>();
     node->AggregateObject(mob);
   }
   mob->SetPosition(pos);
@@ -40,6 +45,31 @@ int main(int argc, char* argv[]) {
 
   double maxRangeMeters = 50.0;
   uint16_t port = 9999;
+  bool nativeBroadcast = true;
+  bool coalesce = true;
+  std::string floodSuppression = "none";
+  uint32_t floodDupThreshold = 3;
+  double floodRebroadcastProb = 0.65;
+  double floodMaxRadS = 0.01;
+  double floodReportAggS = 0.0;
+  bool adaptiveFlood = false;
+  double floodMaxIntervalS = 1.6;
+  std::string hopEngine = "flood";
+  double neighborTtlS = 1.0;
+  bool compactBeacons = true;
+  bool beaconDelta = false;
+  double beaconDivergenceM = 0.0;
+  double beaconKeepaliveS = 0.5;
+  bool adaptiveRates = false;
+  double rateMaxIntervalS = 0.5;
+  bool predictCoverageExit = false;
+  double coverageLeadS = 0.0;
+  bool swarmTick = true;
+  double logRateLimit = 0.0;
+  bool idealChannel = false;
+  double idealDelayS = 1e-6;
+  double idealLoss = 0.0;
+  double idealRateBps = 1e6;
   double simSeconds = 300.0;
   double kAtt = 1.0;
   double kRep = 8.0;
@@ -47,27 +77,84 @@ int main(int argc, char* argv[]) {
   double vMax = 1.0;
   double droneWeightKg = 0.029;
   std::string csvOut = "";
+  std::string traceOut = "";
+  double traceDtS = 0.5;
   std::string animOut = "/output/drone-simulation.xml";
 
 
   CommandLine cmd;
   cmd.AddValue("maxRangeMeters", "Radio max range cutoff (coverage)", maxRangeMeters);
   cmd.AddValue("port", "UDP port for unicast/broadcast", port);
+  cmd.AddValue("coalesce", "Batch each drone's per-tick messages into one datagram per destination", coalesce);
+  cmd.AddValue("floodSuppression", "Flood relay suppression: none|counter|probabilistic", floodSuppression);
+  cmd.AddValue("floodDupThreshold", "Counter suppression: drop a relay after this many copies overheard", floodDupThreshold);
+  cmd.AddValue("floodRebroadcastProb", "Probabilistic suppression: rebroadcast probability", floodRebroadcastProb);
+  cmd.AddValue("floodMaxRadS", "Suppression: max random assessment delay (s)", floodMaxRadS);
+  cmd.AddValue("floodReportAggS", "Merge flood reports sent within this window (s) into one message; 0 disables", floodReportAggS);
+  cmd.AddValue("adaptiveFlood", "Back off base station floods while the topology is stable", adaptiveFlood);
+  cmd.AddValue("floodMaxIntervalS", "Adaptive flooding: longest interval between floods (s)", floodMaxIntervalS);
+  cmd.AddValue("hopEngine", "Hop estimation: flood (base-triggered floods) | dv (distance vector over beacons, no floods)", hopEngine);
+  cmd.AddValue("neighborTtlS", "Drop neighbor entries not refreshed for this long (s); 0 keeps them forever", neighborTtlS);
+  cmd.AddValue("compactBeacons", "Send neighbor beacons as 16-bit fixed point (cm) instead of doubles", compactBeacons);
+  cmd.AddValue("beaconDelta", "Compact beacons: send 8-bit deltas between absolute keyframes", beaconDelta);
+  cmd.AddValue("beaconDivergenceM", "Dead reckoning: skip beacons while neighbors' prediction is within this error (m); 0 beacons every tick", beaconDivergenceM);
+  cmd.AddValue("beaconKeepaliveS", "Dead reckoning: longest gap between beacons (s)", beaconKeepaliveS);
+  cmd.AddValue("adaptiveRates", "Scale POS_UPDATE and beacon rates with speed, acceleration and mission state", adaptiveRates);
+  cmd.AddValue("rateMaxIntervalS", "Adaptive rates: keep-alive interval when still (s)", rateMaxIntervalS);
+  cmd.AddValue("predictCoverageExit", "Send HELP_PROXY at the predicted coverage-boundary crossing instead of after the ACK timeout", predictCoverageExit);
+  cmd.AddValue("coverageLeadS", "Coverage prediction: act this long before the predicted crossing (s)", coverageLeadS);
+  cmd.AddValue("swarmTick", "Drive all drone ticks from one scheduler event per phase bucket (false: one event per drone)", swarmTick);
+  cmd.AddValue("logRateLimit", "Max [Reposition] log records per simulated second for each drone (0: unlimited)", logRateLimit);
+  cmd.AddValue("idealChannel", "Use the ideal range channel instead of the 802.11b stack", idealChannel);
+  cmd.AddValue("idealDelayS", "Ideal channel propagation delay (s)", idealDelayS);
+  cmd.AddValue("idealLoss", "Ideal channel per-receiver loss probability", idealLoss);
+  cmd.AddValue("idealRateBps", "Ideal channel data rate for airtime serialization (bit/s)", idealRateBps);
+  cmd.AddValue("nativeBroadcast", "Send broadcasts as one directed-broadcast frame (false: unicast fan-out)", nativeBroadcast);
   cmd.AddValue("simSeconds", "Simulation stop time", simSeconds);
   cmd.AddValue("kAtt", "Controller attractive gain", kAtt);
   cmd.AddValue("kRep", "Controller repulsive gain", kRep);
   cmd.AddValue("dSafe", "Controller safety distance", dSafe);
   cmd.AddValue("vMax", "Controller max velocity", vMax);
   cmd.AddValue("droneWeightKg", "Controller drone weight (kg)", droneWeightKg);
-  cmd.AddValue("csvOut", "CSV path for reposition logs (empty disables)", csvOut);
+  cmd.AddValue("csvOut", "CSV path for reposition logs, converted from the trajectory trace at the end (empty disables)", csvOut);
+  cmd.AddValue("traceOut", "Binary columnar trajectory trace path (empty: temporary file next to csvOut, if any)", traceOut);
+  cmd.AddValue("traceDtS", "Trajectory sample interval (s); 0 samples every tick", traceDtS);
   cmd.AddValue("animOut", "NetAnim XML output path (empty disables)", animOut);
   cmd.Parse(argc, argv);
 
+  event_log::setRateLimit(LogEvent::REPOSITION, logRateLimit);
+
   sim::RadioEnvironmentConfig radioCfg;
   radioCfg.maxRangeMeters = maxRangeMeters;
+  // Drones refresh their grid cell once per tick and move at most vMax in between.
+  radioCfg.gridDriftMarginMeters = vMax * Ns3Drone::kTickIntervalS;
   radioCfg.port = port;
+  radioCfg.nativeBroadcast = nativeBroadcast;
+  radioCfg.channel = idealChannel ? sim::RadioChannelModel::IDEAL : sim::RadioChannelModel::WIFI;
+  radioCfg.idealPropagationDelayS = idealDelayS;
+  radioCfg.idealLossProbability = idealLoss;
+  radioCfg.idealDataRateBps = idealRateBps;
   sim::RadioEnvironment::Get().Configure(radioCfg);
 
+  FloodSuppressionConfig suppressionCfg;
+  if (floodSuppression == "counter") {
+    suppressionCfg.mode = FloodSuppressionMode::COUNTER;
+  } else if (floodSuppression == "probabilistic") {
+    suppressionCfg.mode = FloodSuppressionMode::PROBABILISTIC;
+  } else if (floodSuppression != "none") {
+    std::cerr << "[Sim] unknown floodSuppression=" << floodSuppression << ", using none" << std::endl;
+  }
+  suppressionCfg.duplicate_threshold = static_cast<uint8_t>(std::min<uint32_t>(floodDupThreshold, UINT8_MAX));
+  suppressionCfg.rebroadcast_probability = floodRebroadcastProb;
+  suppressionCfg.max_assessment_delay_s = floodMaxRadS;
+
+  HopEngine hopEngineKind = HopEngine::FLOOD;
+  if (hopEngine == "dv") {
+    hopEngineKind = HopEngine::DISTANCE_VECTOR;
+  } else if (hopEngine != "flood") {
+    std::cerr << "[Sim] unknown hopEngine=" << hopEngine << ", using flood" << std::endl;
+  }
+
   NodeContainer nodes;
   nodes.Create(1 + 3);  // node 0: base, 1..3: drones
 
@@ -82,22 +169,29 @@ int main(int argc, char* argv[]) {
   Ns3BaseStation base(0, nodes.Get(0));
   base.setPosition(0.0, 0.0, 0.0);
 
-  std::vector<std::unique_ptr<Ns3Drone>> drones;
-  drones.reserve(3);
-
-  std::shared_ptr<std::ofstream> csv;
-  if (!csvOut.empty()) {
-    csv = std::make_shared<std::ofstream>(csvOut);
-    if (csv->good()) {
-      (*csv) << "t,drone,hops,neighbors,x,y,z" << std::endl;
-    } else {
-      std::cerr << "[Sim] failed to open csvOut=" << csvOut << std::endl;
-      csv.reset();
+  FloodScheduleConfig floodSchedule;
+  floodSchedule.adaptive = adaptiveFlood;
+  floodSchedule.max_interval_s = floodMaxIntervalS;
+  floodSchedule.silence_timeout_s = Ns3Drone::kAckTimeoutS;
+  base.setFloodSchedule(floodSchedule);
+
+  Ns3Swarm swarm;
+  swarm.setBatchedTick(swarmTick);
+  const auto& drones = swarm.drones();
+
+  // Samples go to a binary trace; csvOut is produced from it after the run.
+  const std::string tracePath = !traceOut.empty() ? traceOut : (csvOut.empty() ? "" : csvOut + ".trace");
+  std::shared_ptr<TrajectoryTrace> trace;
+  if (!tracePath.empty()) {
+    trace = std::make_shared<TrajectoryTrace>();
+    if (!trace->open(tracePath)) {
+      std::cerr << "[Sim] failed to open trace=" << tracePath << std::endl;
+      trace.reset();
     }
   }
 
   for (uint32_t i = 0; i < 3; ++i) {
-    drones.push_back(std::make_unique<Ns3Drone>(
+    swarm.addDrone(std::make_unique<Ns3Drone>(
       static_cast<uint8_t>(i + 1),
       nodes.Get(i + 1),
       static_cast<float>(kAtt),
@@ -106,8 +200,31 @@ int main(int argc, char* argv[]) {
       static_cast<float>(vMax),
       static_cast<float>(droneWeightKg)
     ));
-    if (csv) {
-      drones.back()->setRepositionLogger(csv);
+    drones.back()->setMessageCoalescing(coalesce);
+    drones.back()->setFloodSuppression(suppressionCfg);
+    drones.back()->setFloodReportAggregation(floodReportAggS);
+    drones.back()->setHopEngine(hopEngineKind);
+    NeighborAgingConfig aging;
+    aging.ttl_s = neighborTtlS;
+    drones.back()->setNeighborAging(aging);
+    NeighborBeaconConfig beaconCfg;
+    beaconCfg.compact = compactBeacons;
+    beaconCfg.delta = beaconDelta;
+    drones.back()->setBeaconFormat(beaconCfg);
+    NeighborPredictionConfig predictionCfg;
+    predictionCfg.divergence_threshold_m = beaconDivergenceM;
+    predictionCfg.keepalive_s = beaconKeepaliveS;
+    drones.back()->setBeaconPrediction(predictionCfg);
+    AdaptiveRateConfig rateCfg;
+    rateCfg.enabled = adaptiveRates;
+    rateCfg.max_interval_s = rateMaxIntervalS;
+    drones.back()->setAdaptiveRates(rateCfg);
+    CoveragePredictionConfig coverageCfg;
+    coverageCfg.enabled = predictCoverageExit;
+    coverageCfg.lead_s = coverageLeadS;
+    drones.back()->setCoveragePrediction(coverageCfg);
+    if (trace) {
+      drones.back()->setTrajectoryTrace(trace, traceDtS);
     }
   }
 
@@ -118,12 +235,13 @@ int main(int argc, char* argv[]) {
   }
 
   // Base station triggers floods periodically (unicast START to initiator).
-  base.start();
+  // The distance-vector engine learns hops from beacons, so floods stay off.
+  if (hopEngineKind == HopEngine::FLOOD) {
+    base.start();
+  }
 
   // Start drones' periodic ticks (POS_UPDATE/ACK tracking + idle motion + HELP_PROXY timeout).
-  for (const auto& d : drones) {
-    d->start();
-  }
+  swarm.start();
 
   std::cout << "[Sim] base coverage=" << maxRangeMeters << "m, drones=3, stop=" << simSeconds << "s" << std::endl;
 
@@ -140,7 +258,64 @@ int main(int argc, char* argv[]) {
   }
   
   Simulator::Stop(Seconds(simSeconds));
+  event_log::startBackgroundDrain();
   Simulator::Run();
+  event_log::stopBackgroundDrain();
+
+  if (trace) {
+    trace->close();
+    std::cout << "[Sim] trajectory samples: " << trace->samples() << std::endl;
+    if (!csvOut.empty()) {
+      if (!trajectoryTraceToCsv(tracePath, csvOut)) {
+        std::cerr << "[Sim] failed to convert trace=" << tracePath << " to csvOut=" << csvOut << std::endl;
+      }
+      if (traceOut.empty()) {
+        std::remove(tracePath.c_str());
+      }
+    }
+  }
+
+  FloodSuppressionStats floodStats;
+  for (const auto& d : drones) {
+    const auto stats = d->floodSuppressionStats();
+    floodStats.relays_sent += stats.relays_sent;
+    floodStats.relays_suppressed += stats.relays_suppressed;
+    floodStats.relays_merged += stats.relays_merged;
+    floodStats.report_agg_frames += stats.report_agg_frames;
+    floodStats.reports_aggregated += stats.reports_aggregated;
+  }
+  std::cout << "[Sim] floods requested by base: " << base.floodsRequested() << std::endl;
+  std::cout << "[Sim] flood relays: sent=" << floodStats.relays_sent
+            << " suppressed=" << floodStats.relays_suppressed
+            << " merged=" << floodStats.relays_merged
+            << " report_agg_frames=" << floodStats.report_agg_frames
+            << " reports_aggregated=" << floodStats.reports_aggregated << std::endl;
+
+  uint64_t neighborsExpired = 0;
+  NeighborBeaconStats beaconStats;
+  AdaptiveRateStats posStats;
+  for (const auto& d : drones) {
+    neighborsExpired += d->neighborAgingStats().expired;
+    beaconStats.sent += d->beaconStats().sent;
+    beaconStats.suppressed += d->beaconStats().suppressed;
+    beaconStats.rate_limited += d->beaconStats().rate_limited;
+    posStats.sent += d->positionUpdateStats().sent;
+    posStats.suppressed += d->positionUpdateStats().suppressed;
+  }
+  std::cout << "[Sim] neighbor entries expired: " << neighborsExpired << std::endl;
+  std::cout << "[Sim] beacons: sent=" << beaconStats.sent << " suppressed=" << beaconStats.suppressed
+            << " rate_limited=" << beaconStats.rate_limited << std::endl;
+  std::cout << "[Sim] position updates: sent=" << posStats.sent << " rate_limited=" << posStats.suppressed << std::endl;
+
+  const auto& spillStats = payloadSpillStats();
+  std::cout << "[Sim] packet payload spills: new_blocks=" << spillStats.new_blocks
+            << " pool_reuses=" << spillStats.pool_reuses
+            << " free_list_growths=" << spillStats.free_list_growths << std::endl;
+
+  const EventLogStats logStats = event_log::stats();
+  std::cout << "[Sim] event log: written=" << logStats.written << " inline_drains=" << logStats.inline_drains
+            << " rate_limited=" << logStats.dropped_rate << std::endl;
+
   Simulator::Destroy();
   return 0;
 }
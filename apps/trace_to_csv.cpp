@@ -0,0 +1,41 @@
+// Converts a binary trajectory trace (help_proxy_sim --traceOut) to the
+// "t,drone,hops,neighbors,x,y,z" CSV that controller_tuner and plotting scripts read.
+//
+//   trace_to_csv <trace> [csv]    (writes to stdout without a csv path)
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "modules/logging/trajectory_trace.h"
+
+int main(int argc, char* argv[]) {
+  if (argc < 2 || argc > 3) {
+    std::cerr << "usage: " << argv[0] << " <trace> [csv]" << std::endl;
+    return 2;
+  }
+
+  std::ifstream in(argv[1], std::ios::binary);
+  if (!in.good()) {
+    std::cerr << "[trace_to_csv] failed to open " << argv[1] << std::endl;
+    return 1;
+  }
+
+  bool ok = false;
+  if (argc == 3) {
+    std::ofstream out(argv[2]);
+    if (!out.good()) {
+      std::cerr << "[trace_to_csv] failed to open " << argv[2] << std::endl;
+      return 1;
+    }
+    ok = trajectoryTraceToCsv(in, out);
+  } else {
+    ok = trajectoryTraceToCsv(in, std::cout);
+  }
+
+  if (!ok) {
+    std::cerr << "[trace_to_csv] malformed or truncated trace " << argv[1] << std::endl;
+    return 1;
+  }
+  return 0;
+}
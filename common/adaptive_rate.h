@@ -0,0 +1,69 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+// Motion-adaptive send interval for periodic streams (position updates, beacons).
+// Activity is the larger of speed / speed_ref_mps and acceleration / accel_ref_mps2,
+// clamped to [0, 1] and raised to at least mission_activity while a mission runs.
+// The interval goes geometrically from max_interval_s (still) to min_interval_s (active).
+struct AdaptiveRateConfig {
+    bool enabled = false;
+    double min_interval_s = 0.05;
+    double max_interval_s = 0.5;  // keep-alive
+    double speed_ref_mps = 1.0;
+    double accel_ref_mps2 = 2.0;
+    double mission_activity = 0.5;
+};
+
+struct AdaptiveRateStats {
+    uint64_t sent = 0;
+    uint64_t suppressed = 0;
+};
+
+class AdaptiveRate {
+    public:
+        void setConfig(const AdaptiveRateConfig& new_config) { rate_config = new_config; }
+        const AdaptiveRateConfig& config() const { return rate_config; }
+        const AdaptiveRateStats& stats() const { return rate_stats; }
+
+        double interval(double speed_mps, double accel_mps2, bool mission_active) const {
+            double activity = std::max(ratio(speed_mps, rate_config.speed_ref_mps), ratio(accel_mps2, rate_config.accel_ref_mps2));
+            if (mission_active) {
+                activity = std::max(activity, rate_config.mission_activity);
+            }
+            activity = std::clamp(activity, 0.0, 1.0);
+            if (rate_config.min_interval_s <= 0.0 || rate_config.max_interval_s <= rate_config.min_interval_s) {
+                return rate_config.min_interval_s;
+            }
+            return rate_config.max_interval_s * std::pow(rate_config.min_interval_s / rate_config.max_interval_s, activity);
+        }
+
+        // True (and the send is recorded) if the interval for the current motion has elapsed
+        // since the last send, or `force` is set. Always true when disabled.
+        bool shouldSend(double now_s, double speed_mps, double accel_mps2, bool mission_active, bool force = false) {
+            if (!rate_config.enabled || force || !has_sent ||
+                (now_s - last_send_s) + kSlackS >= interval(speed_mps, accel_mps2, mission_active)) {
+                has_sent = true;
+                last_send_s = now_s;
+                ++rate_stats.sent;
+                return true;
+            }
+            ++rate_stats.suppressed;
+            return false;
+        }
+
+    private:
+        // Sends land on a tick grid; the slack keeps an interval of k ticks from slipping to k+1.
+        static constexpr double kSlackS = 1e-6;
+
+        static double ratio(double value, double reference) {
+            return reference > 0.0 ? value / reference : 0.0;
+        }
+
+        AdaptiveRateConfig rate_config;
+        AdaptiveRateStats rate_stats;
+        bool has_sent = false;
+        double last_send_s = 0.0;
+};
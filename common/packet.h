@@ -1,7 +1,9 @@
 #pragma once
 
 #include <cstdint>
-#include <vector>
+#include <span>
+
+#include "common/packet_payload.h"
 
 // Broadcast destination node id.
 constexpr uint8_t BROADCAST_ID = 0xFF;
@@ -12,11 +14,28 @@ enum class PacketType : uint8_t {
   CORE = 1,
   FLOOD = 2,
   NEIGHBOR = 3,
+  // Framing only (CommunicationManager coalescing): one datagram carrying several
+  // records for the same destination. Never surfaces to handlers.
+  BATCH = 0x7F,
 };
 
 struct Packet {
   PacketType type = PacketType::UNKNOWN;
   uint8_t src;
   uint8_t dst;  // BROADCAST_ID = broadcast
-  std::vector<uint8_t> payload;
+  ::PacketPayload payload;  // inline up to PacketPayload::kInlineCapacity bytes
+};
+
+// Received packet: same header as Packet, but the payload is a non-owning view into the
+// transport's receive buffer. Only valid for the duration of the receive callback.
+struct PacketView {
+  PacketType type = PacketType::UNKNOWN;
+  uint8_t src = 0;
+  uint8_t dst = 0;  // BROADCAST_ID = broadcast
+  std::span<const uint8_t> payload;
+
+  PacketView() = default;
+
+  // Lets locally built packets be fed to receive-side handlers.
+  PacketView(const Packet& pkt) : type(pkt.type), src(pkt.src), dst(pkt.dst), payload(pkt.payload) {}
 };
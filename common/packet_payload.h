@@ -0,0 +1,213 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <vector>
+
+// Counters for payloads that spill out of the inline buffer. They cover the spill blocks
+// and the pool's own free lists only; other heap use on the messaging path is not measured.
+struct PayloadSpillStats {
+  uint64_t pool_reuses = 0;        // spills served from a recycled pool block
+  uint64_t new_blocks = 0;         // spills that had to allocate a new block
+  uint64_t free_list_growths = 0;  // releases that grew a free list past its reserve
+};
+
+inline PayloadSpillStats& payloadSpillStats() {
+  static thread_local PayloadSpillStats stats;
+  return stats;
+}
+
+// Free lists of spill blocks in power-of-two size classes (128 B .. 4 KiB).
+// Blocks are never returned to the system; larger payloads get an exact heap block.
+// Free lists are reserved up front, so releasing does not allocate until more than
+// kFreeListReserve blocks of one class are parked at once.
+class PacketPayloadPool {
+ public:
+  static constexpr size_t kMinBlock = 128;
+  static constexpr size_t kClasses = 6;
+  static constexpr size_t kMaxBlock = kMinBlock << (kClasses - 1);
+  static constexpr size_t kFreeListReserve = 64;
+
+  // Rounds `size` up to the block size that acquire() will hand out.
+  static size_t blockSize(size_t size) {
+    if (size > kMaxBlock) {
+      return size;
+    }
+    size_t block = kMinBlock;
+    while (block < size) {
+      block <<= 1;
+    }
+    return block;
+  }
+
+  static uint8_t* acquire(size_t block_size) {
+    auto& stats = payloadSpillStats();
+    const int cls = sizeClass(block_size);
+    if (cls >= 0) {
+      auto& free_list = instance().m_free[static_cast<size_t>(cls)];
+      if (!free_list.empty()) {
+        uint8_t* block = free_list.back();
+        free_list.pop_back();
+        ++stats.pool_reuses;
+        return block;
+      }
+    }
+    ++stats.new_blocks;
+    return new uint8_t[block_size];
+  }
+
+  static void release(uint8_t* block, size_t block_size) {
+    const int cls = sizeClass(block_size);
+    if (cls < 0) {
+      delete[] block;
+      return;
+    }
+    auto& free_list = instance().m_free[static_cast<size_t>(cls)];
+    if (free_list.size() == free_list.capacity()) {
+      ++payloadSpillStats().free_list_growths;
+    }
+    free_list.push_back(block);
+  }
+
+ private:
+  static int sizeClass(size_t block_size) {
+    size_t block = kMinBlock;
+    for (size_t cls = 0; cls < kClasses; ++cls, block <<= 1) {
+      if (block == block_size) {
+        return static_cast<int>(cls);
+      }
+    }
+    return -1;
+  }
+
+  static PacketPayloadPool& instance() {
+    static thread_local PacketPayloadPool pool;
+    return pool;
+  }
+
+  PacketPayloadPool() {
+    for (auto& free_list : m_free) {
+      free_list.reserve(kFreeListReserve);
+    }
+  }
+
+  ~PacketPayloadPool() {
+    for (auto& free_list : m_free) {
+      for (uint8_t* block : free_list) {
+        delete[] block;
+      }
+    }
+  }
+
+  std::array<std::vector<uint8_t*>, kClasses> m_free;
+};
+
+// Packet payload with inline storage for the common case. Every protocol message fits in
+// kInlineCapacity bytes; larger payloads spill to a PacketPayloadPool block.
+// Mirrors the subset of std::vector<uint8_t> the modules use.
+class PacketPayload {
+ public:
+  static constexpr size_t kInlineCapacity = 64;
+
+  PacketPayload() = default;
+  PacketPayload(const PacketPayload& other) { assign(other.data(), other.size()); }
+  PacketPayload(PacketPayload&& other) noexcept { moveFrom(other); }
+  ~PacketPayload() { releaseSpill(); }
+
+  PacketPayload& operator=(const PacketPayload& other) {
+    if (this != &other) {
+      assign(other.data(), other.size());
+    }
+    return *this;
+  }
+
+  PacketPayload& operator=(PacketPayload&& other) noexcept {
+    if (this != &other) {
+      releaseSpill();
+      moveFrom(other);
+    }
+    return *this;
+  }
+
+  // Grows or shrinks the payload, keeping the existing prefix; new bytes are zeroed.
+  void resize(size_t new_size) {
+    if (new_size > capacity()) {
+      grow(new_size, data(), m_size);
+    }
+    if (new_size > m_size) {
+      std::memset(data() + m_size, 0, new_size - m_size);
+    }
+    m_size = new_size;
+  }
+
+  void assign(const uint8_t* src, size_t n) {
+    if (n > capacity()) {
+      // grow() copies `src` before releasing the old block, which `src` may point into.
+      grow(n, src, n);
+    } else if (n > 0) {
+      std::memmove(data(), src, n);
+    }
+    m_size = n;
+  }
+
+  void clear() { m_size = 0; }
+
+  uint8_t* data() { return m_spill ? m_spill : m_inline.data(); }
+  const uint8_t* data() const { return m_spill ? m_spill : m_inline.data(); }
+  size_t size() const { return m_size; }
+  bool empty() const { return m_size == 0; }
+  size_t capacity() const { return m_spill ? m_spill_capacity : kInlineCapacity; }
+
+  uint8_t& operator[](size_t i) { return data()[i]; }
+  const uint8_t& operator[](size_t i) const { return data()[i]; }
+
+  uint8_t* begin() { return data(); }
+  uint8_t* end() { return data() + m_size; }
+  const uint8_t* begin() const { return data(); }
+  const uint8_t* end() const { return data() + m_size; }
+
+  operator std::span<const uint8_t>() const { return {data(), m_size}; }
+
+ private:
+  // Moves to a block of at least `min_capacity` holding the `n` bytes at `src`.
+  void grow(size_t min_capacity, const uint8_t* src, size_t n) {
+    const size_t block_size = PacketPayloadPool::blockSize(min_capacity);
+    uint8_t* block = PacketPayloadPool::acquire(block_size);
+    if (n > 0) {
+      std::memcpy(block, src, n);
+    }
+    releaseSpill();
+    m_spill = block;
+    m_spill_capacity = block_size;
+  }
+
+  void releaseSpill() {
+    if (m_spill) {
+      PacketPayloadPool::release(m_spill, m_spill_capacity);
+      m_spill = nullptr;
+      m_spill_capacity = 0;
+    }
+  }
+
+  void moveFrom(PacketPayload& other) {
+    m_size = other.m_size;
+    if (other.m_spill) {
+      m_spill = other.m_spill;
+      m_spill_capacity = other.m_spill_capacity;
+      other.m_spill = nullptr;
+      other.m_spill_capacity = 0;
+    } else if (m_size > 0) {
+      std::memcpy(m_inline.data(), other.m_inline.data(), m_size);
+    }
+    other.m_size = 0;
+  }
+
+  std::array<uint8_t, kInlineCapacity> m_inline;
+  uint8_t* m_spill = nullptr;
+  size_t m_spill_capacity = 0;
+  size_t m_size = 0;
+};
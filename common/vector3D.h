@@ -1,13 +1,21 @@
 #pragma once
 #include <cmath>
+#include <type_traits>
 
 struct Vector3D {
-    double x, y, z;
+    double x = 0.0;
+    double y = 0.0;
+    double z = 0.0;
 
-    Vector3D(double x, double y, double z) : x(x), y(y), z(z) {}
+    constexpr Vector3D() = default;
+    constexpr Vector3D(double x, double y, double z) : x(x), y(y), z(z) {}
+
+    constexpr double squared_module() const {
+        return x * x + y * y + z * z;
+    }
 
     double module() const {
-        return std::sqrt(x * x + y * y + z * z);
+        return std::sqrt(squared_module());
     }
 
     Vector3D unit_vector() const {
@@ -22,7 +30,7 @@ struct Vector3D {
         );
     }
 
-    Vector3D operator+(const Vector3D& other) const {
+    constexpr Vector3D operator+(const Vector3D& other) const {
         return {
             x + other.x, 
             y + other.y, 
@@ -30,7 +38,7 @@ struct Vector3D {
         };
     }
 
-    Vector3D operator-(const Vector3D& other) const {
+    constexpr Vector3D operator-(const Vector3D& other) const {
         return {
             x - other.x, 
             y - other.y, 
@@ -38,7 +46,7 @@ struct Vector3D {
         };
     }
 
-    Vector3D operator*(double scalar) const {
+    constexpr Vector3D operator*(double scalar) const {
         return {
             x * scalar, 
             y * scalar, 
@@ -47,6 +55,9 @@ struct Vector3D {
     }
 };
 
-inline Vector3D operator*(double scalar, const Vector3D& v) {
+constexpr Vector3D operator*(double scalar, const Vector3D& v) {
     return v * scalar;
 }
+
+// Passed by value through every position API.
+static_assert(std::is_trivially_copyable_v<Vector3D>, "Vector3D must be trivially copyable");
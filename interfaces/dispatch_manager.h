@@ -8,7 +8,7 @@
 
 class DispatchManagerInterface {
  public:
-  using FallbackHandler = std::function<void(const ::Packet&)>;
+  using FallbackHandler = std::function<void(const ::PacketView&)>;
 
   virtual ~DispatchManagerInterface() = default;
 
@@ -16,5 +16,5 @@ class DispatchManagerInterface {
   virtual void setNeighborManager(NeighborManagerInterface* neighbor_manager) = 0;
   virtual void setFallbackHandler(FallbackHandler handler) = 0;
 
-  virtual void handlePacket(const ::Packet& pkt) const = 0;
+  virtual void handlePacket(const ::PacketView& pkt) const = 0;
 };
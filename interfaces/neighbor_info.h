@@ -1,12 +1,15 @@
 #pragma once
 #include <cstdint>
-#include <vector>
+#include <span>
+
+#include "common/packet_payload.h"
+#include "common/vector3D.h"
 
 class NeighborInfoInterface {
     public:
         virtual ~NeighborInfoInterface() = default;
-        virtual std::vector<double> getPosition() const = 0;
+        virtual Vector3D getPosition() const = 0;
         virtual uint8_t getHopsToBaseStation() const = 0;
-        virtual void serialize(std::vector<uint8_t>& out_payload) const = 0;
-        virtual void deserialize(const std::vector<uint8_t>& in_payload) = 0;
+        virtual void serialize(::PacketPayload& out_payload) const = 0;
+        virtual void deserialize(std::span<const uint8_t> in_payload) = 0;
 };
\ No newline at end of file
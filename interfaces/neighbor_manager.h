@@ -1,16 +1,31 @@
 #pragma once
+#include <cstddef>
 #include <cstdint>
+#include <span>
 #include <vector> 
 
 #include "interfaces/neighbor_info.h"
 #include "interfaces/communication_manager.h"
 #include "interfaces/position.h"
 
+// Read-only struct-of-arrays view of the live neighbors: element i of every span
+// describes the same neighbor. Valid until the table is next modified.
+struct NeighborSpan {
+    std::span<const uint8_t> ids;
+    std::span<const double> x;
+    std::span<const double> y;
+    std::span<const double> z;
+    std::span<const uint8_t> hops;
+
+    size_t size() const { return ids.size(); }
+    bool empty() const { return ids.empty(); }
+};
+
 class NeighborManagerInterface {
     public:
         virtual ~NeighborManagerInterface() = default;
-        virtual void onPacketReceived(const ::Packet& pkt) = 0;
-        virtual std::vector<NeighborInfoInterface*> getNeighbors() const = 0;
+        virtual void onPacketReceived(const ::PacketView& pkt) = 0;
+        virtual NeighborSpan neighbors() const = 0;
         virtual void sendToNeighbors(
             uint8_t id, 
             PositionInterface* position,
@@ -1,5 +1,4 @@
 #pragma once
-#include <vector>
 
 #include "common/vector3D.h"
 
@@ -7,7 +6,9 @@ class PositionInterface {
     public:
         virtual ~PositionInterface() = default;
         virtual void retrieveCurrentPosition() = 0;
-        virtual std::vector<double> getCoordinates() const = 0;
+        virtual Vector3D getCoordinates() const = 0;
         virtual Vector3D distanceFrom(const PositionInterface* other) const = 0;
-        virtual Vector3D distanceFromCoords(const std::vector<double>& other_coords) const = 0;
+        virtual Vector3D distanceFromCoords(Vector3D other_coords) const = 0;
+        // Velocity at the last retrieveCurrentPosition() (m/s).
+        virtual Vector3D getVelocity() const = 0;
 };
\ No newline at end of file
@@ -2,13 +2,16 @@
 
 #include <cstdint>
 #include <functional>
+#include <span>
 #include <vector>
 
 // Transport is the lowest layer used by the simulator's module-level CommunicationManager.
 class Transport {
  public:
   using Bytes = std::vector<uint8_t>;
-  using RxCallback = std::function<void(const Bytes&)>;
+  // Non-owning view of a received datagram; only valid during the RxCallback call.
+  using BytesView = std::span<const uint8_t>;
+  using RxCallback = std::function<void(BytesView)>;
 
   virtual ~Transport() = default;
 
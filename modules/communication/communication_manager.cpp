@@ -3,7 +3,7 @@
 CommunicationManager::CommunicationManager(std::unique_ptr<::Transport> transport, uint8_t self_id)
 		: m_transport(std::move(transport)), m_self_id(self_id) {
 	if (m_transport) {
-		m_transport->SetRxCallback([this](const ::Transport::Bytes& bytes) { handleRxBytes(bytes); });
+		m_transport->SetRxCallback([this](::Transport::BytesView bytes) { handleRxBytes(bytes); });
 	}
 }
 
@@ -18,25 +18,104 @@ void CommunicationManager::setReceiveHandler(ReceiveHandler handler) {
 	m_on_receive = std::move(handler);
 }
 
+void CommunicationManager::setCoalescing(bool enabled) {
+	if (m_coalescing && !enabled) {
+		flush();
+	}
+	m_coalescing = enabled;
+}
+
 void CommunicationManager::send(const ::Packet& pkt) {
 	if (!m_transport) {
 		return;
 	}
+	if (m_coalescing) {
+		enqueue(pkt);
+		return;
+	}
 
-	::Transport::Bytes bytes;
-	bytes.resize(3 + pkt.payload.size());
+	// Reuse one frame buffer: after the first send it never reallocates.
+	::Transport::Bytes& bytes = m_tx_buffer;
+	bytes.resize(kFrameHeaderBytes + pkt.payload.size());
 	bytes[0] = pkt.src;
 	bytes[1] = pkt.dst;
 	bytes[2] = static_cast<uint8_t>(pkt.type);
 	if (!pkt.payload.empty()) {
-		std::memcpy(bytes.data() + 3, pkt.payload.data(), pkt.payload.size());
+		std::memcpy(bytes.data() + kFrameHeaderBytes, pkt.payload.data(), pkt.payload.size());
 	}
 
-	if (pkt.dst == BROADCAST_ID) {
+	sendFrame(bytes, pkt.dst);
+}
+
+void CommunicationManager::sendFrame(const ::Transport::Bytes& bytes, uint8_t dst) {
+	if (dst == BROADCAST_ID) {
 		m_transport->SendBroadcast(bytes);
 	} else {
-		m_transport->SendUnicast(pkt.dst, bytes);
+		m_transport->SendUnicast(dst, bytes);
+	}
+}
+
+void CommunicationManager::enqueue(const ::Packet& pkt) {
+	const size_t record_size = kRecordHeaderBytes + pkt.payload.size();
+	::Transport::Bytes& batch = m_batches[pkt.dst];
+	if (!batch.empty() && batch.size() + record_size > kMaxBatchBytes) {
+		flushDestination(pkt.dst);
+	}
+
+	if (batch.empty()) {
+		m_pending_dsts.push_back(pkt.dst);
+		batch.push_back(m_self_id);
+		batch.push_back(pkt.dst);
+		batch.push_back(static_cast<uint8_t>(::PacketType::BATCH));
+	}
+
+	const size_t offset = batch.size();
+	const uint16_t len = static_cast<uint16_t>(pkt.payload.size());
+	batch.resize(offset + record_size);
+	batch[offset] = pkt.src;
+	batch[offset + 1] = static_cast<uint8_t>(pkt.type);
+	batch[offset + 2] = static_cast<uint8_t>(len & 0xFF);
+	batch[offset + 3] = static_cast<uint8_t>(len >> 8);
+	if (len > 0) {
+		std::memcpy(batch.data() + offset + kRecordHeaderBytes, pkt.payload.data(), len);
+	}
+	++m_batch_records[pkt.dst];
+}
+
+void CommunicationManager::flush() {
+	if (!m_transport) {
+		return;
+	}
+	for (const uint8_t dst : m_pending_dsts) {
+		flushDestination(dst);
+	}
+	m_pending_dsts.clear();
+}
+
+void CommunicationManager::flushDestination(uint8_t dst) {
+	::Transport::Bytes& batch = m_batches[dst];
+	if (batch.empty()) {
+		return;
+	}
+
+	if (m_batch_records[dst] == 1) {
+		// A lone record goes out as a plain frame: no batching overhead.
+		const uint8_t* record = batch.data() + kFrameHeaderBytes;
+		const size_t len = batch.size() - kFrameHeaderBytes - kRecordHeaderBytes;
+		m_tx_buffer.resize(kFrameHeaderBytes + len);
+		m_tx_buffer[0] = record[0];
+		m_tx_buffer[1] = dst;
+		m_tx_buffer[2] = record[1];
+		if (len > 0) {
+			std::memcpy(m_tx_buffer.data() + kFrameHeaderBytes, record + kRecordHeaderBytes, len);
+		}
+		sendFrame(m_tx_buffer, dst);
+	} else {
+		sendFrame(batch, dst);
 	}
+
+	batch.clear();
+	m_batch_records[dst] = 0;
 }
 
 void CommunicationManager::receive(::Packet& pkt) {
@@ -45,22 +124,42 @@ void CommunicationManager::receive(::Packet& pkt) {
 	}
 }
 
-void CommunicationManager::handleRxBytes(const ::Transport::Bytes& bytes) {
+void CommunicationManager::handleRxBytes(::Transport::BytesView bytes) {
 	if (!m_on_receive) {
 		return;
 	}
-	if (bytes.size() < 3) {
+	if (bytes.size() < kFrameHeaderBytes) {
 		return;
 	}
 
-	::Packet decoded;
+	// The payload aliases the transport buffer: no copy on the way up to the handlers.
+	::PacketView decoded;
 	decoded.src = bytes[0];
 	decoded.dst = bytes[1];
 	decoded.type = static_cast<::PacketType>(bytes[2]);
-	if (bytes.size() > 3) {
-		decoded.payload.assign(bytes.begin() + 3, bytes.end());
+
+	if (decoded.type != ::PacketType::BATCH) {
+		decoded.payload = bytes.subspan(kFrameHeaderBytes);
+		m_on_receive(decoded);
+	} else {
+		// Split a coalesced datagram back into its records.
+		size_t offset = kFrameHeaderBytes;
+		while (offset + kRecordHeaderBytes <= bytes.size()) {
+			const size_t len = static_cast<size_t>(bytes[offset + 2]) |
+				(static_cast<size_t>(bytes[offset + 3]) << 8);
+			if (offset + kRecordHeaderBytes + len > bytes.size()) {
+				break;
+			}
+			decoded.src = bytes[offset];
+			decoded.type = static_cast<::PacketType>(bytes[offset + 1]);
+			decoded.payload = bytes.subspan(offset + kRecordHeaderBytes, len);
+			m_on_receive(decoded);
+			offset += kRecordHeaderBytes + len;
+		}
 	}
 
-	m_on_receive(decoded);
+	// Replies and relays triggered by this datagram leave together, right away.
+	if (m_coalescing) {
+		flush();
+	}
 }
-
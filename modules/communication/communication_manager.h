@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <functional>
 #include <memory>
 #include <vector>
@@ -11,7 +12,7 @@
 
 class CommunicationManager : public CommunicationManagerInterface {
     public:
-        using ReceiveHandler = std::function<void(const ::Packet&)>;
+        using ReceiveHandler = std::function<void(const ::PacketView&)>;
 
         CommunicationManager(std::unique_ptr<::Transport> transport, uint8_t self_id);
 
@@ -22,10 +23,33 @@ class CommunicationManager : public CommunicationManagerInterface {
         void send(const ::Packet& pkt) override;
         void receive(::Packet& pkt) override;
 
+        // Coalescing: while enabled, send() only queues packets, and flush() emits one
+        // datagram per destination carrying every record queued since the last flush.
+        // A destination with a single queued record gets a plain (unbatched) frame.
+        // Sends triggered while handling a received datagram are flushed automatically;
+        // the owner calls flush() at the end of its tick.
+        void setCoalescing(bool enabled);
+        void flush();
+
         private:
-        void handleRxBytes(const ::Transport::Bytes& bytes);
+        // Batched datagram: [src][dst][PacketType::BATCH] then records
+        // [src][type][len_lo][len_hi][payload...]. Keeps each record's own src (relays).
+        static constexpr size_t kFrameHeaderBytes = 3;
+        static constexpr size_t kRecordHeaderBytes = 4;
+        static constexpr size_t kMaxBatchBytes = 1400;
+
+        void handleRxBytes(::Transport::BytesView bytes);
+        void sendFrame(const ::Transport::Bytes& bytes, uint8_t dst);
+        void enqueue(const ::Packet& pkt);
+        void flushDestination(uint8_t dst);
 
         std::unique_ptr<::Transport> m_transport;
         uint8_t m_self_id;
         ReceiveHandler m_on_receive;
+        ::Transport::Bytes m_tx_buffer;
+
+        bool m_coalescing = false;
+        std::array<::Transport::Bytes, 256> m_batches;  // indexed by destination id
+        std::array<uint16_t, 256> m_batch_records{};
+        std::vector<uint8_t> m_pending_dsts;
 };
\ No newline at end of file
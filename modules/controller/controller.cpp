@@ -29,17 +29,8 @@ void Controller::setIdleVelocity(const Vector3D& velocity) {
     idle_velocity = velocity;
 }
 
-void Controller::computeAttractiveForces(const Vector3D& diff, Vector3D& force) {
-    force = force + (K_att * diff);
-}
-
-void Controller::computeRepulsiveForces(const Vector3D& diff, Vector3D& force) {
-    float distance = diff.module();
-    if (distance == 0) {
-        // Avoid division by zero
-        return; 
-    }
-    force = force - (K_rep / std::pow(distance, 2)) * diff.unit_vector();
+FormationForceParams Controller::forceParams() const {
+    return FormationForceParams{K_att, K_rep, D_safe};
 }
 
 void Controller::computeVelocityCommand(const Vector3D& force, Vector3D* new_acceleration) {
@@ -76,23 +67,13 @@ void Controller::step(
     }
     
 
-    const auto neighbors = neighbor_manager->getNeighbors();
+    const NeighborSpan neighbors = neighbor_manager->neighbors();
     position->retrieveCurrentPosition();
+    const Vector3D self_coords = position->getCoordinates();
     const uint8_t hops_from_base_station = flooding_manager->getHopsFromBase();
 
-    Vector3D F_tot = Vector3D{0.0f, 0.0f, 0.0f};
-    for (const NeighborInfoInterface* neighbor : neighbors) {
-        const uint8_t neighbor_hops = neighbor->getHopsToBaseStation();
-        Vector3D diff = position->distanceFromCoords(neighbor->getPosition());
-        if (neighbor_hops < hops_from_base_station || neighbor_hops > hops_from_base_station) {
-            // Attractive force
-            computeAttractiveForces(diff, F_tot);
-        }
-        if (diff.module() < D_safe) {
-            // Repulsive force
-            computeRepulsiveForces(diff, F_tot);
-        }
-    }
+    // Attraction to neighbors with a different hop count, repulsion inside D_safe.
+    const Vector3D F_tot = computeFormationForce(forceParams(), self_coords, hops_from_base_station, neighbors);
 
     // Velocity Command
     Vector3D new_acceleration(0.0, 0.0, 0.0);
@@ -10,6 +10,7 @@
 #include "interfaces/position.h"
 #include "interfaces/neighbor_manager.h"
 #include "interfaces/neighbor_info.h"
+#include "modules/controller/formation_kernel.h"
 
 const float DEFAULT_K_ATT = 1;
 const float DEFAULT_K_REP = 1;
@@ -32,6 +33,8 @@ class Controller {
         bool isMissionActive() const;
 
         void setIdleVelocity(const Vector3D& velocity);
+        // Gains for computeFormationForce(s), e.g. to batch several drones' force evaluations.
+        FormationForceParams forceParams() const;
         void step(
             FloodManagerInterface* flooding_manager,
             VelocityActuatorInterface* velocity_actuator,
@@ -50,7 +53,5 @@ class Controller {
         Vector3D idle_velocity{0.5f, 0.0f, 0.0f};
         float min_difference = 100;
         
-        void computeAttractiveForces(const Vector3D& diff, Vector3D& force);
-        void computeRepulsiveForces(const Vector3D& diff, Vector3D& force);
         void computeVelocityCommand(const Vector3D& force, Vector3D* new_accelerations);
 };
\ No newline at end of file
@@ -0,0 +1,159 @@
+#include "modules/controller/formation_kernel.h"
+
+#include <cmath>
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define FORMATION_KERNEL_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// Accumulates neighbors [begin, size) onto `force`; shared by the scalar path and the
+// AVX2 tail.
+Vector3D accumulateScalar(
+    const FormationForceParams& params,
+    Vector3D self,
+    uint8_t self_hops,
+    const NeighborSpan& neighbors,
+    size_t begin,
+    Vector3D force
+) {
+    const double d_safe2 = params.d_safe * params.d_safe;
+    for (size_t i = begin; i < neighbors.size(); ++i) {
+        const double dx = neighbors.x[i] - self.x;
+        const double dy = neighbors.y[i] - self.y;
+        const double dz = neighbors.z[i] - self.z;
+        const double d2 = dx * dx + dy * dy + dz * dz;
+
+        double coef = neighbors.hops[i] != self_hops ? params.k_att : 0.0;
+        if (d2 > 0.0 && d2 < d_safe2) {
+            const double inv = 1.0 / std::sqrt(d2);
+            coef -= params.k_rep * inv * inv * inv;
+        }
+        force.x += coef * dx;
+        force.y += coef * dy;
+        force.z += coef * dz;
+    }
+    return force;
+}
+
+#ifdef FORMATION_KERNEL_X86
+
+__attribute__((target("avx2,fma"))) double horizontalSum(__m256d v) {
+    const __m128d pair = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(pair, _mm_unpackhi_pd(pair, pair)));
+}
+
+#endif
+
+}  // namespace
+
+bool formationKernelHasAvx2() {
+#ifdef FORMATION_KERNEL_X86
+    static const bool supported = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+Vector3D formationForceScalar(
+    const FormationForceParams& params,
+    Vector3D self,
+    uint8_t self_hops,
+    const NeighborSpan& neighbors
+) {
+    return accumulateScalar(params, self, self_hops, neighbors, 0, Vector3D(0.0, 0.0, 0.0));
+}
+
+#ifdef FORMATION_KERNEL_X86
+
+__attribute__((target("avx2,fma"))) Vector3D formationForceAvx2(
+    const FormationForceParams& params,
+    Vector3D self,
+    uint8_t self_hops,
+    const NeighborSpan& neighbors
+) {
+    const __m256d self_x = _mm256_set1_pd(self.x);
+    const __m256d self_y = _mm256_set1_pd(self.y);
+    const __m256d self_z = _mm256_set1_pd(self.z);
+    const __m256d k_att = _mm256_set1_pd(params.k_att);
+    const __m256d k_rep = _mm256_set1_pd(params.k_rep);
+    const __m256d d_safe2 = _mm256_set1_pd(params.d_safe * params.d_safe);
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256i hops = _mm256_set1_epi64x(self_hops);
+
+    __m256d fx = zero;
+    __m256d fy = zero;
+    __m256d fz = zero;
+
+    const size_t n = neighbors.size();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(neighbors.x.data() + i), self_x);
+        const __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(neighbors.y.data() + i), self_y);
+        const __m256d dz = _mm256_sub_pd(_mm256_loadu_pd(neighbors.z.data() + i), self_z);
+        const __m256d d2 = _mm256_fmadd_pd(dz, dz, _mm256_fmadd_pd(dy, dy, _mm256_mul_pd(dx, dx)));
+
+        int32_t hops4;
+        std::memcpy(&hops4, neighbors.hops.data() + i, sizeof(hops4));
+        const __m256i neighbor_hops = _mm256_cvtepu8_epi64(_mm_cvtsi32_si128(hops4));
+        const __m256d same_hops = _mm256_castsi256_pd(_mm256_cmpeq_epi64(neighbor_hops, hops));
+        const __m256d attract = _mm256_andnot_pd(same_hops, k_att);
+
+        // d2 == 0 gives inv = inf; the mask zeroes those lanes before they are used.
+        const __m256d inv = _mm256_div_pd(one, _mm256_sqrt_pd(d2));
+        const __m256d in_range = _mm256_and_pd(
+            _mm256_cmp_pd(d2, zero, _CMP_GT_OQ), _mm256_cmp_pd(d2, d_safe2, _CMP_LT_OQ));
+        const __m256d repulse = _mm256_and_pd(in_range, _mm256_mul_pd(k_rep, _mm256_mul_pd(inv, _mm256_mul_pd(inv, inv))));
+
+        const __m256d coef = _mm256_sub_pd(attract, repulse);
+        fx = _mm256_fmadd_pd(coef, dx, fx);
+        fy = _mm256_fmadd_pd(coef, dy, fy);
+        fz = _mm256_fmadd_pd(coef, dz, fz);
+    }
+
+    const Vector3D force(horizontalSum(fx), horizontalSum(fy), horizontalSum(fz));
+    return accumulateScalar(params, self, self_hops, neighbors, i, force);
+}
+
+#else
+
+Vector3D formationForceAvx2(
+    const FormationForceParams& params,
+    Vector3D self,
+    uint8_t self_hops,
+    const NeighborSpan& neighbors
+) {
+    return formationForceScalar(params, self, self_hops, neighbors);
+}
+
+#endif
+
+Vector3D computeFormationForce(
+    const FormationForceParams& params,
+    Vector3D self,
+    uint8_t self_hops,
+    const NeighborSpan& neighbors
+) {
+    if (formationKernelHasAvx2()) {
+        return formationForceAvx2(params, self, self_hops, neighbors);
+    }
+    return formationForceScalar(params, self, self_hops, neighbors);
+}
+
+void computeFormationForces(
+    const FormationForceParams& params,
+    std::span<const FormationForceQuery> queries,
+    std::span<Vector3D> out
+) {
+    const bool avx2 = formationKernelHasAvx2();
+    for (size_t q = 0; q < queries.size(); ++q) {
+        const FormationForceQuery& query = queries[q];
+        out[q] = avx2 ? formationForceAvx2(params, query.self, query.hops, query.neighbors)
+                      : formationForceScalar(params, query.self, query.hops, query.neighbors);
+    }
+}
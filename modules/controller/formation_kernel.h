@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+#include "common/vector3D.h"
+#include "interfaces/neighbor_manager.h"
+
+// Batched formation-force evaluation over the packed neighbor arrays.
+// For each neighbor, with diff = p_neighbor - p_self and d = |diff|:
+// - attraction  K_att * diff            if its hop count differs from ours;
+// - repulsion  -K_rep / d^2 * diff / d  if 0 < d < D_safe.
+// Both terms fold into one coefficient on diff, and a single 1/sqrt(d^2) per pair gives
+// the distance test and the unit vector. On x86 the AVX2 path (4 neighbors per step) is
+// picked at run time when the CPU supports it; the scalar path is used otherwise.
+struct FormationForceParams {
+  double k_att = 1.0;
+  double k_rep = 1.0;
+  double d_safe = 1.0;
+};
+
+struct FormationForceQuery {
+  Vector3D self;
+  uint8_t hops = 0;
+  NeighborSpan neighbors;
+};
+
+Vector3D computeFormationForce(
+    const FormationForceParams& params, Vector3D self, uint8_t self_hops, const NeighborSpan& neighbors);
+
+// Evaluates many drones' controllers in one call: out[i] is the force for queries[i].
+// `out` must be at least as long as `queries`.
+void computeFormationForces(
+    const FormationForceParams& params, std::span<const FormationForceQuery> queries, std::span<Vector3D> out);
+
+// The individual paths, for benchmarking. formationForceAvx2 may only be called when
+// formationKernelHasAvx2() is true.
+bool formationKernelHasAvx2();
+Vector3D formationForceScalar(
+    const FormationForceParams& params, Vector3D self, uint8_t self_hops, const NeighborSpan& neighbors);
+Vector3D formationForceAvx2(
+    const FormationForceParams& params, Vector3D self, uint8_t self_hops, const NeighborSpan& neighbors);
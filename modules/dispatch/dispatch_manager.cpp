@@ -12,7 +12,7 @@ void DispatchManager::setFallbackHandler(FallbackHandler handler) {
   m_fallback_handler = std::move(handler);
 }
 
-void DispatchManager::handlePacket(const ::Packet& pkt) const {
+void DispatchManager::handlePacket(const ::PacketView& pkt) const {
   switch (pkt.type) {
     case ::PacketType::FLOOD:
       if (m_flood_manager) {
@@ -12,7 +12,7 @@ class DispatchManager final : public DispatchManagerInterface {
   void setNeighborManager(NeighborManagerInterface* neighbor_manager) override;
   void setFallbackHandler(FallbackHandler handler) override;
 
-  void handlePacket(const ::Packet& pkt) const override;
+  void handlePacket(const ::PacketView& pkt) const override;
  private:
   FloodManagerInterface* m_flood_manager = nullptr;
   NeighborManagerInterface* m_neighbor_manager = nullptr;
@@ -0,0 +1,92 @@
+#include "modules/flood/distance_vector_manager.h"
+
+DistanceVectorManager::DistanceVectorManager(
+    uint8_t self,
+    const NeighborManagerInterface* neighbors,
+    const DistanceVectorConfig& cfg
+) :
+    self_id(self),
+    neighbor_manager(neighbors),
+    config(cfg)
+{ }
+
+void DistanceVectorManager::onPacketReceived(const ::PacketView&) {
+}
+
+uint8_t DistanceVectorManager::getHopsFromBase() const {
+    return hops_from_base;
+}
+
+void DistanceVectorManager::setBaseId(uint8_t base) {
+    base_id = base;
+}
+
+void DistanceVectorManager::setBaseReachable(bool reachable, double now_s) {
+    if (base_reachable == reachable) {
+        return;
+    }
+    base_reachable = reachable;
+    recompute(now_s);
+}
+
+void DistanceVectorManager::onNeighborBeacon(uint8_t neighbor_id, double now_s) {
+    if (neighbor_id == self_id || neighbor_id == base_id) {
+        return;
+    }
+    recompute(now_s);
+}
+
+void DistanceVectorManager::tick(double now_s) {
+    recompute(now_s);
+}
+
+void DistanceVectorManager::recompute(double now_s) {
+    if (base_reachable) {
+        hops_from_base = 1;
+        feasible_hops = 1;
+        in_hold_down = false;
+        return;
+    }
+
+    // Hold-down over: forget the old distance so any neighbor is acceptable again.
+    if (in_hold_down && now_s >= hold_down_until_s) {
+        in_hold_down = false;
+        feasible_hops = UINT8_MAX;
+    }
+
+    uint8_t best = UINT8_MAX;
+    if (neighbor_manager) {
+        // The base shows up in the table through its ACKs; it is not a relay candidate.
+        const NeighborSpan table = neighbor_manager->neighbors();
+        for (size_t i = 0; i < table.size(); ++i) {
+            const uint8_t hops = table.hops[i];
+            if (table.ids[i] == self_id || table.ids[i] == base_id ||
+                hops >= feasible_hops || hops >= config.max_hops) {
+                continue;
+            }
+            if (hops + 1 < best) {
+                best = static_cast<uint8_t>(hops + 1);
+            }
+        }
+    }
+
+    if (best != UINT8_MAX) {
+        hops_from_base = best;
+        if (best < feasible_hops) {
+            feasible_hops = best;
+        }
+        in_hold_down = false;
+        return;
+    }
+
+    // Lost our route: poison it for hold_down_s so neighbors that went through us let go.
+    if (hops_from_base != UINT8_MAX && !in_hold_down) {
+        in_hold_down = true;
+        hold_down_until_s = now_s + config.hold_down_s;
+    }
+    hops_from_base = UINT8_MAX;
+}
+
+void DistanceVectorManager::startFlood(uint16_t) {
+    // No floods: hops propagate through neighbor beacons.
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+
+#include "interfaces/flood_manager.h"
+#include "interfaces/neighbor_manager.h"
+
+struct DistanceVectorConfig {
+    double hold_down_s = 0.5;  // route poisoned (advertised as unknown) after a loss
+    uint8_t max_hops = 16;     // "infinity": longer routes are treated as unreachable
+};
+
+// Hop estimation without floods: hops = min(neighbor hops) + 1, learned from the
+// hops_to_base_station field every drone already puts in its neighbor beacon.
+//
+// Neighbors and their advertised hops are read from the NeighborManager table, so a
+// neighbor stays usable exactly as long as its entry lives (the neighbor aging TTL,
+// which is kept above the beacon keep-alives).
+//
+// Beacons are broadcast and do not name the sender's parent, so per-neighbor split
+// horizon is replaced by its broadcast equivalent, a feasibility check: a neighbor is
+// only usable if it advertises strictly fewer hops than the best route we have held
+// since the last loss. Routes derived from our own advertisement (>= our hops) are
+// therefore never taken. When no feasible neighbor remains the route goes into
+// hold-down: we advertise UINT8_MAX so dependents drop us, and only after hold_down_s
+// is any neighbor accepted again.
+class DistanceVectorManager : public FloodManagerInterface {
+    public:
+        DistanceVectorManager(
+            uint8_t self_id,
+            const NeighborManagerInterface* neighbor_manager,
+            const DistanceVectorConfig& config = {}
+        );
+
+        // Floods are not used by this engine; FLOOD packets are ignored.
+        void onPacketReceived(const ::PacketView& pkt) override;
+
+        // Returns the cached estimate; it is recomputed (one pass over the live neighbors)
+        // on beacons, reachability changes and ticks.
+        uint8_t getHopsFromBase() const override;
+
+        void setBaseId(uint8_t base_id);
+        void setBaseReachable(bool reachable, double now_s);
+
+        // Re-evaluates after the neighbor table took a beacon. Beacons from the base itself
+        // are ignored: direct reachability comes from setBaseReachable (ACK-based).
+        void onNeighborBeacon(uint8_t neighbor_id, double now_s);
+
+        // Picks up neighbors the table aged out and ends hold-down; call once per tick,
+        // after the neighbor table has advanced.
+        void tick(double now_s);
+
+    private:
+        uint8_t self_id;
+        const NeighborManagerInterface* neighbor_manager;
+        uint8_t base_id = 0;
+        DistanceVectorConfig config;
+
+        bool base_reachable = false;
+        uint8_t hops_from_base = UINT8_MAX;
+
+        // Best hops held since the last loss; candidates must advertise strictly less.
+        uint8_t feasible_hops = UINT8_MAX;
+        bool in_hold_down = false;
+        double hold_down_until_s = 0.0;
+
+        void recompute(double now_s);
+
+        void startFlood(uint16_t flood_id) override;
+};
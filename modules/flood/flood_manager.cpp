@@ -2,15 +2,14 @@
 
 FloodManager::FloodManager(
     uint8_t self,
-    CommunicationManagerInterface& cm,
-    std::function<bool()> base_reachable_fn
+    CommunicationManagerInterface& cm
 ) :
     self_id(self),
     communication_manager(cm),
-    is_base_reachable(std::move(base_reachable_fn))
+    rng(self)
 { }
 
-void FloodManager::onPacketReceived(const ::Packet& pkt) {
+void FloodManager::onPacketReceived(const ::PacketView& pkt) {
     if (pkt.payload.empty()) {
         return;
     }
@@ -39,6 +38,14 @@ void FloodManager::onPacketReceived(const ::Packet& pkt) {
             }
             break;
         }
+        case FloodMsgType::REPORT_AGG: {
+            FloodReportAggHeader header;
+            std::span<const uint8_t> entries;
+            if (decodeReportAgg(pkt, header, entries)) {
+                handleReportAgg(header, entries);
+            }
+            break;
+        }
         default:
             // unrecognized message type
             return;
@@ -50,40 +57,98 @@ void FloodManager::setBaseId(uint8_t base) {
 }
 
 uint8_t FloodManager::getHopsFromBase() const {
-    if (is_base_reachable && is_base_reachable()) {
-        return 1;
+    return hops_from_base;
+}
+
+void FloodManager::setBaseReachable(bool reachable) {
+    if (base_reachable == reachable) {
+        return;
     }
+    base_reachable = reachable;
+    refreshHopsFromBase();
+}
 
-    // higher flood_id means more recent flood
-    uint16_t latest_flood_id = 0;
-    for (auto [flood_id, hops_to_base] : best_hop_to_base) {
-        latest_flood_id = (latest_flood_id < flood_id) ? flood_id : latest_flood_id;
+void FloodManager::refreshHopsFromBase() {
+    if (base_reachable) {
+        hops_from_base = 1;
+        return;
     }
-    auto it = best_hop_to_base.find(latest_flood_id);
-    if (it == best_hop_to_base.end()) {
+
+    // The latest flood (serial order) carries the freshest hop estimate.
+    const FloodSlot* latest = has_latest_flood ? findFlood(latest_flood_id) : nullptr;
+    if (!latest) {
         // no floods seen yet
-        return UINT8_MAX;
+        hops_from_base = UINT8_MAX;
+        return;
     }
 
     // If the base is not reachable now, we must not report a direct hop (1)
     // based on stale flood state from when we *were* directly connected.
-    if (it->second == 1) {
-        return UINT8_MAX;
+    if (latest->best_hop_to_base == 1) {
+        hops_from_base = UINT8_MAX;
+        return;
     }
 
-    return static_cast<uint8_t>(it->second);
+    hops_from_base = latest->best_hop_to_base;
+}
+
+bool FloodManager::isNewerFlood(uint16_t a, uint16_t b) {
+    return static_cast<int16_t>(static_cast<uint16_t>(a - b)) > 0;
+}
+
+FloodManager::FloodSlot* FloodManager::findFlood(uint16_t flood_id) {
+    FloodSlot& slot = floods[flood_id % FLOOD_WINDOW];
+    return (slot.valid && slot.flood_id == flood_id) ? &slot : nullptr;
+}
+
+const FloodManager::FloodSlot* FloodManager::findFlood(uint16_t flood_id) const {
+    const FloodSlot& slot = floods[flood_id % FLOOD_WINDOW];
+    return (slot.valid && slot.flood_id == flood_id) ? &slot : nullptr;
+}
+
+FloodManager::FloodSlot* FloodManager::joinFlood(uint16_t flood_id, uint8_t initiator_id) {
+    if (has_latest_flood && !isNewerFlood(flood_id, latest_flood_id)) {
+        const uint16_t age = static_cast<uint16_t>(latest_flood_id - flood_id);
+        if (age >= FLOOD_WINDOW) {
+            // Too old: its ring slot now belongs to a newer flood.
+            return nullptr;
+        }
+    }
+    if (!has_latest_flood || isNewerFlood(flood_id, latest_flood_id)) {
+        has_latest_flood = true;
+        latest_flood_id = flood_id;
+    }
+
+    FloodSlot& slot = floods[flood_id % FLOOD_WINDOW];
+    slot.valid = true;
+    slot.flood_id = flood_id;
+    slot.initiator_id = initiator_id;
+    slot.best_hop_to_base = UINT8_MAX;
+    slot.best_report_seen.fill(UINT8_MAX);
+    slot.discovery_relay_pending = false;
+    slot.discovery_copies = 0;
+    slot.report_relay_pending.reset();
+    slot.report_copies.fill(0);
+    slot.report_agg_pending.reset();
+    slot.report_agg_scheduled = false;
+    refreshHopsFromBase();
+    return &slot;
 }
 
 void FloodManager::startFlood(uint16_t flood_id) {
     // Initiator seeds the flood.
+    FloodSlot* flood = joinFlood(flood_id, self_id);
+    if (!flood) {
+        return;
+    }
+    flood->best_hop_to_base = 1;
+    refreshHopsFromBase();
+
     FloodDiscoveryMsg msg;
     msg.flood_id = flood_id;
     msg.initiator_id = self_id;
     msg.hop_to_base = 0;
 
-    seen_floods.insert(flood_id);
-    best_hop_to_base[flood_id] = 1;
-
     ::Packet pkt;
     pkt.type = ::PacketType::FLOOD;
     pkt.src = self_id;
@@ -97,7 +162,7 @@ void FloodManager::startFlood(uint16_t flood_id) {
 void FloodManager::handleStart(const FloodStartMsg& msg) {
     // Base requests this node to act as initiator.
     // Avoid restarting the same flood multiple times.
-    if (seen_floods.count(msg.flood_id)) {
+    if (findFlood(msg.flood_id)) {
         return;
     }
     startFlood(msg.flood_id);
@@ -108,67 +173,240 @@ void FloodManager::handleDiscovery(const FloodDiscoveryMsg& msg) {
     const uint8_t initiator_id = msg.initiator_id;
 
     // Compute candidate hop to initiator.
-    const bool base_reachable = (is_base_reachable && is_base_reachable());
     const uint8_t candidate_hop = base_reachable
         ? static_cast<uint8_t>(1)
         : static_cast<uint8_t>(msg.hop_to_base + 1);
 
-    bool improved = false;
-    auto it = best_hop_to_base.find(flood_id);
-    if (it == best_hop_to_base.end()) {
-        improved = true;
-        best_hop_to_base[flood_id] = candidate_hop;
-        seen_floods.insert(flood_id);
-    } else if (candidate_hop < it->second) {
-        improved = true;
-        it->second = candidate_hop;
+    FloodSlot* flood = findFlood(flood_id);
+    if (!flood) {
+        flood = joinFlood(flood_id, initiator_id);
+        if (!flood) {
+            // Stale flood that already left our window.
+            return;
+        }
     }
-
-    if (!improved) {
+    if (candidate_hop >= flood->best_hop_to_base) {
+        // A neighbor relayed this flood too: counts against our own pending relay.
+        if (flood->discovery_relay_pending && flood->discovery_copies < UINT8_MAX) {
+            ++flood->discovery_copies;
+        }
         return;
     }
+    flood->best_hop_to_base = candidate_hop;
+    if (flood_id == latest_flood_id) {
+        refreshHopsFromBase();
+    }
 
     // Mark our own report as seen so we don't forward an echoed copy later.
-    best_report_seen[flood_id][self_id] = candidate_hop;
-    ::Packet report_pkt = createReportMsg(flood_id, initiator_id, candidate_hop);
-    communication_manager.send(report_pkt);
+    flood->best_report_seen[self_id] = candidate_hop;
+    emitReport(*flood, self_id);
 
     // Rebroadcast discovery with incremented hop.
-    ::Packet flood_pkt = createDiscoveryMsg(flood_id, initiator_id, candidate_hop);
-    communication_manager.send(flood_pkt);
+    relayDiscovery(*flood);
 }
 
 void FloodManager::handleReport(const FloodReportMsg& msg) {
-    // Ignore reports for floods we never joined (limits propagation scope).
-    if (!seen_floods.count(msg.flood_id)) {
+    handleReportEntry(msg.flood_id, msg.reporter_id, msg.hop_to_base);
+}
+
+void FloodManager::handleReportAgg(const FloodReportAggHeader& header, std::span<const uint8_t> entries) {
+    for (uint8_t i = 0; i < header.count; ++i) {
+        FloodReportEntry entry;
+        std::memcpy(&entry, entries.data() + i * sizeof(FloodReportEntry), sizeof(entry));
+        handleReportEntry(header.flood_id, entry.reporter_id, entry.hop_to_base);
+    }
+}
+
+void FloodManager::handleReportEntry(uint16_t flood_id, uint8_t reporter_id, uint8_t hop_to_base) {
+    // Ignore reports for floods we never joined or that left the window (limits propagation scope).
+    FloodSlot* flood = findFlood(flood_id);
+    if (!flood) {
         return;
     }
 
     // Forward each reporter's best-known report at most once per improvement.
-    bool improved = false;
-    auto& seen = best_report_seen[msg.flood_id];
-    auto it_seen = seen.find(msg.reporter_id);
-    if (it_seen == seen.end() || msg.hop_to_base < it_seen->second) {
-        improved = true;
-        seen[msg.reporter_id] = msg.hop_to_base;
+    uint8_t& seen = flood->best_report_seen[reporter_id];
+    if (hop_to_base >= seen) {
+        if (flood->report_relay_pending[reporter_id] && flood->report_copies[reporter_id] < UINT8_MAX) {
+            ++flood->report_copies[reporter_id];
+        }
+        return;
     }
+    seen = hop_to_base;
+
+    // Non-initiators rebroadcast reports so they can reach the initiator over multiple hops.
+    relayReport(*flood, reporter_id);
+}
+
+void FloodManager::setReportAggregation(double window_s) {
+    report_aggregation_window_s = window_s;
+}
 
-    if (!improved) {
+void FloodManager::emitReport(FloodSlot& flood, uint8_t reporter_id) {
+    if (!scheduler || report_aggregation_window_s <= 0.0) {
+        communication_manager.send(
+            createReportMsg(flood.flood_id, flood.initiator_id, reporter_id, flood.best_report_seen[reporter_id]));
         return;
     }
 
-    // Non-initiators rebroadcast reports so they can reach the initiator over multiple hops.
-    ::Packet report_pkt = createReportMsg(msg.flood_id, msg.initiator_id, msg.hop_to_base);
-    communication_manager.send(report_pkt);
+    flood.report_agg_pending[reporter_id] = true;
+    if (flood.report_agg_scheduled) {
+        return;
+    }
+    flood.report_agg_scheduled = true;
+    const uint16_t flood_id = flood.flood_id;
+    scheduler(report_aggregation_window_s, [this, flood_id]() { flushReportAggregate(flood_id); });
 }
 
-::Packet FloodManager::createReportMsg(uint16_t flood_id, uint8_t initiator_id, uint8_t candidate_hop) {
-    // Create a report with the best hop we currently know.
+void FloodManager::flushReportAggregate(uint16_t flood_id) {
+    FloodSlot* flood = findFlood(flood_id);
+    if (!flood || !flood->report_agg_scheduled) {
+        return;
+    }
+    flood->report_agg_scheduled = false;
+
+    FloodReportAggHeader header;
+    header.flood_id = flood_id;
+    header.initiator_id = flood->initiator_id;
+    header.count = 0;
+
+    ::Packet pkt;
+    pkt.type = ::PacketType::FLOOD;
+    pkt.src = self_id;
+    pkt.dst = BROADCAST_ID;
+
+    // Entries carry the best hop known now, so later improvements inside the window win.
+    const auto send_frame = [&]() {
+        std::memcpy(pkt.payload.data(), &header, sizeof(header));
+        communication_manager.send(pkt);
+        ++suppression_stats.report_agg_frames;
+        suppression_stats.reports_aggregated += header.count;
+        header.count = 0;
+    };
+    for (size_t reporter = 0; reporter < flood->report_agg_pending.size(); ++reporter) {
+        if (!flood->report_agg_pending[reporter]) {
+            continue;
+        }
+        if (header.count == FLOOD_REPORT_AGG_MAX_ENTRIES) {
+            send_frame();
+        }
+        FloodReportEntry entry;
+        entry.reporter_id = static_cast<uint8_t>(reporter);
+        entry.hop_to_base = flood->best_report_seen[reporter];
+        pkt.payload.resize(sizeof(header) + (header.count + 1) * sizeof(entry));
+        std::memcpy(pkt.payload.data() + sizeof(header) + header.count * sizeof(entry), &entry, sizeof(entry));
+        ++header.count;
+    }
+    if (header.count > 0) {
+        send_frame();
+    }
+    flood->report_agg_pending.reset();
+}
+
+void FloodManager::setSuppression(const FloodSuppressionConfig& config) {
+    suppression = config;
+}
+
+void FloodManager::setScheduler(Scheduler sched) {
+    scheduler = std::move(sched);
+}
+
+const FloodSuppressionStats& FloodManager::suppressionStats() const {
+    return suppression_stats;
+}
+
+void FloodManager::relayDiscovery(FloodSlot& flood) {
+    if (suppression.mode == FloodSuppressionMode::NONE) {
+        ++suppression_stats.relays_sent;
+        communication_manager.send(createDiscoveryMsg(flood.flood_id, flood.initiator_id, flood.best_hop_to_base));
+        return;
+    }
+    if (flood.discovery_relay_pending) {
+        // The pending relay will carry the improved hop.
+        ++suppression_stats.relays_merged;
+        return;
+    }
+    flood.discovery_relay_pending = true;
+    flood.discovery_copies = 0;
+    const uint16_t flood_id = flood.flood_id;
+    scheduleAssessment([this, flood_id]() { assessDiscovery(flood_id); });
+}
+
+void FloodManager::relayReport(FloodSlot& flood, uint8_t reporter_id) {
+    if (suppression.mode == FloodSuppressionMode::NONE) {
+        ++suppression_stats.relays_sent;
+        emitReport(flood, reporter_id);
+        return;
+    }
+    if (flood.report_relay_pending[reporter_id]) {
+        ++suppression_stats.relays_merged;
+        return;
+    }
+    flood.report_relay_pending[reporter_id] = true;
+    flood.report_copies[reporter_id] = 0;
+    const uint16_t flood_id = flood.flood_id;
+    scheduleAssessment([this, flood_id, reporter_id]() { assessReport(flood_id, reporter_id); });
+}
+
+void FloodManager::assessDiscovery(uint16_t flood_id) {
+    FloodSlot* flood = findFlood(flood_id);
+    if (!flood || !flood->discovery_relay_pending) {
+        // Evicted from the window while waiting.
+        return;
+    }
+    flood->discovery_relay_pending = false;
+    if (!shouldRelay(flood->discovery_copies)) {
+        ++suppression_stats.relays_suppressed;
+        return;
+    }
+    ++suppression_stats.relays_sent;
+    communication_manager.send(createDiscoveryMsg(flood_id, flood->initiator_id, flood->best_hop_to_base));
+}
+
+void FloodManager::assessReport(uint16_t flood_id, uint8_t reporter_id) {
+    FloodSlot* flood = findFlood(flood_id);
+    if (!flood || !flood->report_relay_pending[reporter_id]) {
+        return;
+    }
+    flood->report_relay_pending[reporter_id] = false;
+    if (!shouldRelay(flood->report_copies[reporter_id])) {
+        ++suppression_stats.relays_suppressed;
+        return;
+    }
+    ++suppression_stats.relays_sent;
+    emitReport(*flood, reporter_id);
+}
+
+void FloodManager::scheduleAssessment(std::function<void()> task) {
+    if (!scheduler || suppression.max_assessment_delay_s <= 0.0) {
+        task();
+        return;
+    }
+    std::uniform_real_distribution<double> delay(0.0, suppression.max_assessment_delay_s);
+    scheduler(delay(rng), std::move(task));
+}
+
+bool FloodManager::shouldRelay(uint8_t copies_heard) {
+    switch (suppression.mode) {
+        case FloodSuppressionMode::COUNTER:
+            return copies_heard < suppression.duplicate_threshold;
+        case FloodSuppressionMode::PROBABILISTIC: {
+            std::uniform_real_distribution<double> coin(0.0, 1.0);
+            return coin(rng) < suppression.rebroadcast_probability;
+        }
+        case FloodSuppressionMode::NONE:
+        default:
+            return true;
+    }
+}
+
+::Packet FloodManager::createReportMsg(uint16_t flood_id, uint8_t initiator_id, uint8_t reporter_id, uint8_t hop_to_base) {
+    // Create a report carrying `reporter_id`'s best known hop.
     FloodReportMsg report;
     report.flood_id = flood_id;
     report.initiator_id = initiator_id;
-    report.reporter_id = self_id;
-    report.hop_to_base = candidate_hop;
+    report.reporter_id = reporter_id;
+    report.hop_to_base = hop_to_base;
 
     ::Packet report_pkt;
     report_pkt.type = ::PacketType::FLOOD;
@@ -195,7 +433,7 @@ void FloodManager::handleReport(const FloodReportMsg& msg) {
     return pkt;
 }
 
-bool FloodManager::decodeStart(const ::Packet& pkt, FloodStartMsg& msg) {
+bool FloodManager::decodeStart(const ::PacketView& pkt, FloodStartMsg& msg) {
     if (pkt.payload.size() < sizeof(FloodStartMsg)) {
         return false;
     }
@@ -203,7 +441,7 @@ bool FloodManager::decodeStart(const ::Packet& pkt, FloodStartMsg& msg) {
     return msg.type == FloodMsgType::START;
 }
 
-bool FloodManager::decodeDiscovery(const ::Packet& pkt, FloodDiscoveryMsg& msg) {
+bool FloodManager::decodeDiscovery(const ::PacketView& pkt, FloodDiscoveryMsg& msg) {
     if (pkt.payload.size() < sizeof(FloodDiscoveryMsg)) {
         return false;
     }
@@ -211,10 +449,19 @@ bool FloodManager::decodeDiscovery(const ::Packet& pkt, FloodDiscoveryMsg& msg)
     return msg.type == FloodMsgType::DISCOVERY;
 }
 
-bool FloodManager::decodeReport(const ::Packet& pkt, FloodReportMsg& msg) {
+bool FloodManager::decodeReport(const ::PacketView& pkt, FloodReportMsg& msg) {
     if (pkt.payload.size() < sizeof(FloodReportMsg)) {
         return false;
     }
     std::memcpy(&msg, pkt.payload.data(), sizeof(FloodReportMsg));
     return msg.type == FloodMsgType::REPORT;
 }
+
+bool FloodManager::decodeReportAgg(const ::PacketView& pkt, FloodReportAggHeader& header, std::span<const uint8_t>& entries) {
+    if (pkt.payload.size() < sizeof(FloodReportAggHeader)) {
+        return false;
+    }
+    std::memcpy(&header, pkt.payload.data(), sizeof(FloodReportAggHeader));
+    entries = pkt.payload.subspan(sizeof(FloodReportAggHeader));
+    return header.type == FloodMsgType::REPORT_AGG && entries.size() >= header.count * sizeof(FloodReportEntry);
+}
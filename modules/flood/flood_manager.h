@@ -1,9 +1,11 @@
 #pragma once
 
+#include <array>
+#include <bitset>
 #include <cstdint>
 #include <functional>
-#include <unordered_map>
-#include <unordered_set>
+#include <random>
+#include <span>
 #include <vector>
 #include <cstring>
 #include <iostream>
@@ -12,45 +14,144 @@
 
 #include "modules/flood/flood_messages.h"
 
+// Broadcast-storm suppression for DISCOVERY/REPORT relays.
+enum class FloodSuppressionMode : uint8_t {
+    NONE = 0,           // relay every improvement immediately
+    COUNTER = 1,        // relay after a random assessment delay unless k copies were overheard
+    PROBABILISTIC = 2,  // relay after a random assessment delay with a fixed probability
+};
+
+struct FloodSuppressionConfig {
+    FloodSuppressionMode mode = FloodSuppressionMode::NONE;
+    uint8_t duplicate_threshold = 3;        // k, for COUNTER
+    double rebroadcast_probability = 0.65;  // for PROBABILISTIC
+    double max_assessment_delay_s = 0.01;   // assessment delay is uniform in [0, max]
+};
+
+struct FloodSuppressionStats {
+    uint64_t relays_sent = 0;
+    uint64_t relays_suppressed = 0;  // dropped at assessment (k copies heard / coin flip)
+    uint64_t relays_merged = 0;      // improvements folded into an already pending relay
+    uint64_t report_agg_frames = 0;  // REPORT_AGG frames sent
+    uint64_t reports_aggregated = 0; // report entries carried by those frames
+};
+
 class FloodManager : public FloodManagerInterface {
     public:
+        // Runs `task` after `delay_s` seconds of simulated time.
+        using Scheduler = std::function<void(double delay_s, std::function<void()> task)>;
+
         FloodManager(
             uint8_t self_id,
-            CommunicationManagerInterface& communication_manager,
-            std::function<bool()> is_base_reachable = {}
+            CommunicationManagerInterface& communication_manager
         );
 
-        void onPacketReceived(const ::Packet& pkt) override;
+        void onPacketReceived(const ::PacketView& pkt) override;
 
         void setBaseId(uint8_t base_id);
 
         // Returns the number of hops from this node to the base station.
+        // Constant time: the estimate is maintained as floods arrive and reachability changes.
         uint8_t getHopsFromBase() const override;
 
+        // Direct reachability of the base (ACK-based), pushed by the owner on every change,
+        // including ACK timeouts.
+        void setBaseReachable(bool reachable);
+
+        // Suppression needs a scheduler for the assessment delay; without one, relays
+        // are assessed immediately.
+        void setSuppression(const FloodSuppressionConfig& config);
+        void setScheduler(Scheduler scheduler);
+        const FloodSuppressionStats& suppressionStats() const;
+
+        // Report aggregation: reports emitted within `window_s` of the first one are merged
+        // into REPORT_AGG frames (0 disables; also needs a scheduler).
+        void setReportAggregation(double window_s);
+
     private:
         uint8_t base_id = 0;
         uint8_t self_id;
         CommunicationManagerInterface& communication_manager;
-        std::function<bool()> is_base_reachable;
+        bool base_reachable = false;
+        uint8_t hops_from_base = UINT8_MAX;
+
+        // Flood state is kept only for the most recent FLOOD_WINDOW flood ids, in a ring
+        // indexed by flood_id % FLOOD_WINDOW, so memory stays constant with run length.
+        // Flood ids are uint16_t and wrap: ordering uses serial-number arithmetic.
+        static constexpr size_t FLOOD_WINDOW = 16;
 
-        std::unordered_map<uint16_t, uint8_t> best_hop_to_base;
+        struct FloodSlot {
+            bool valid = false;
+            uint16_t flood_id = 0;
+            uint8_t initiator_id = 0;
+            uint8_t best_hop_to_base = UINT8_MAX;
 
-        // For multi-hop reporting: track the best hop_to_initiator we've seen per reporter
-        // so we forward each reporter's report at most once per improvement.
-        std::unordered_map<uint16_t, std::unordered_map<uint8_t, uint8_t>> best_report_seen;
+            // For multi-hop reporting: track the best hop_to_initiator we've seen per reporter
+            // so we forward each reporter's report at most once per improvement.
+            // UINT8_MAX = no report seen from that reporter.
+            std::array<uint8_t, 256> best_report_seen;
 
-        std::unordered_set<uint16_t> seen_floods;
+            // Suppression: relays waiting for their assessment, and the copies of the same
+            // message overheard meanwhile.
+            bool discovery_relay_pending = false;
+            uint8_t discovery_copies = 0;
+            std::bitset<256> report_relay_pending;
+            std::array<uint8_t, 256> report_copies;
+
+            // Aggregation: reporters whose best report goes out in the next REPORT_AGG.
+            std::bitset<256> report_agg_pending;
+            bool report_agg_scheduled = false;
+        };
+
+        std::array<FloodSlot, FLOOD_WINDOW> floods;
+        bool has_latest_flood = false;
+        uint16_t latest_flood_id = 0;
+
+        // True if `a` is a more recent flood id than `b` (RFC 1982 style, 16-bit).
+        static bool isNewerFlood(uint16_t a, uint16_t b);
+
+        // Slot of `flood_id` if we joined that flood and it is still in the window.
+        FloodSlot* findFlood(uint16_t flood_id);
+        const FloodSlot* findFlood(uint16_t flood_id) const;
+
+        // Starts tracking `flood_id`, evicting the flood that used its ring slot.
+        // Returns nullptr if the id has already fallen out of the window.
+        FloodSlot* joinFlood(uint16_t flood_id, uint8_t initiator_id);
+
+        // Recomputes hops_from_base from reachability and the latest flood.
+        void refreshHopsFromBase();
 
         void startFlood(uint16_t flood_id) override;
 
         void handleStart(const FloodStartMsg& flood_id);
         void handleDiscovery(const FloodDiscoveryMsg& msg);
         void handleReport(const FloodReportMsg& msg);
+        void handleReportAgg(const FloodReportAggHeader& header, std::span<const uint8_t> entries);
+        void handleReportEntry(uint16_t flood_id, uint8_t reporter_id, uint8_t hop_to_base);
+
+        double report_aggregation_window_s = 0.0;
+
+        // Sends `reporter_id`'s best report, alone or through the aggregation window.
+        void emitReport(FloodSlot& flood, uint8_t reporter_id);
+        void flushReportAggregate(uint16_t flood_id);
+
+        FloodSuppressionConfig suppression;
+        FloodSuppressionStats suppression_stats;
+        Scheduler scheduler;
+        std::minstd_rand rng;
+
+        void relayDiscovery(FloodSlot& flood);
+        void relayReport(FloodSlot& flood, uint8_t reporter_id);
+        void assessDiscovery(uint16_t flood_id);
+        void assessReport(uint16_t flood_id, uint8_t reporter_id);
+        void scheduleAssessment(std::function<void()> task);
+        bool shouldRelay(uint8_t copies_heard);
 
-        ::Packet createReportMsg(uint16_t flood_id, uint8_t initiator_id, uint8_t candidate_hop);
+        ::Packet createReportMsg(uint16_t flood_id, uint8_t initiator_id, uint8_t reporter_id, uint8_t hop_to_base);
         ::Packet createDiscoveryMsg(uint16_t flood_id, uint8_t initiator_id, uint8_t hop_to_base);
 
-        static bool decodeStart(const ::Packet& pkt, FloodStartMsg& msg);
-        static bool decodeDiscovery(const ::Packet& pkt, FloodDiscoveryMsg& msg);
-        static bool decodeReport(const ::Packet& pkt, FloodReportMsg& msg);
+        static bool decodeStart(const ::PacketView& pkt, FloodStartMsg& msg);
+        static bool decodeDiscovery(const ::PacketView& pkt, FloodDiscoveryMsg& msg);
+        static bool decodeReport(const ::PacketView& pkt, FloodReportMsg& msg);
+        static bool decodeReportAgg(const ::PacketView& pkt, FloodReportAggHeader& header, std::span<const uint8_t>& entries);
 };
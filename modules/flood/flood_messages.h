@@ -6,10 +6,12 @@
 // - START:      base (host) -> initiator (direct link / appchannel)
 // - DISCOVERY:  swarm broadcast, forwarded hop-by-hop
 // - REPORT:     swarm broadcast, each node reports its best hop-to-initiator
+// - REPORT_AGG: swarm broadcast, several reporters' REPORT entries in one frame
 enum class FloodMsgType : uint8_t {
     START = 0,
     DISCOVERY = 1,
     REPORT = 2,
+    REPORT_AGG = 3,
 };
 
 #pragma pack(push, 1)
@@ -36,8 +38,26 @@ struct FloodReportMsg {
     uint8_t hop_to_base;
 };
 
+// Swarm broadcast: aggregated reports. Followed by `count` FloodReportEntry records.
+struct FloodReportAggHeader {
+    FloodMsgType type = FloodMsgType::REPORT_AGG;
+    uint16_t flood_id;
+    uint8_t initiator_id;
+    uint8_t count;
+};
+
+struct FloodReportEntry {
+    uint8_t reporter_id;
+    uint8_t hop_to_base;
+};
+
 #pragma pack(pop)
 
+// Keeps an aggregated report within Packet's inline payload (64 bytes).
+constexpr uint8_t FLOOD_REPORT_AGG_MAX_ENTRIES = 29;
+
 static_assert(sizeof(FloodStartMsg) == 3, "FloodStartMsg must be packed");
 static_assert(sizeof(FloodDiscoveryMsg) == 5, "FloodDiscoveryMsg must be packed");
 static_assert(sizeof(FloodReportMsg) == 6, "FloodReportMsg must be packed");
+static_assert(sizeof(FloodReportAggHeader) == 5, "FloodReportAggHeader must be packed");
+static_assert(sizeof(FloodReportEntry) == 2, "FloodReportEntry must be packed");
@@ -0,0 +1,262 @@
+#include "modules/logging/event_log.h"
+
+#include <cmath>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr size_t kRingSize = 1024;  // records per thread, power of two
+constexpr size_t kEventCount = static_cast<size_t>(LogEvent::COUNT);
+constexpr size_t kRateSources = 256;  // rate-limit windows per event, keyed by drone id
+
+// "{t}" is the record time, each "{}" the next field. A line ends at the first "{}" left
+// without a field, dropping that word (e.g. HELP_PROXY TX without a position).
+constexpr const char* kFormats[kEventCount] = {
+  "[Mission] t={t}s drone={} mission_active=1",
+  "[Reposition] t={t}s delta_t={}s drone={} hops={} neighbors={} pos=({},{},{}) help_proxy_rx={}s help_proxy_tx={}s",
+  "[HELP_PROXY TX] t={t}s drone={} reason={} last_ack={}s pos=({},{},{})",
+  "[HELP_PROXY RX] t={t}s drone={} requester={} pos=({},{},{})",
+  "[RELAYED_ACK_RX] t={t}s drone={} seq={}",
+};
+
+// Single producer (the owning thread), single consumer (whoever holds the drain lock).
+struct LogRing {
+  std::array<LogRecord, kRingSize> records;
+  std::atomic<size_t> head{0};
+  std::atomic<size_t> tail{0};
+
+  // Producer-only rate-limit windows (one simulated second each), per event and source.
+  std::array<std::array<int64_t, kRateSources>, kEventCount> window{};
+  std::array<std::array<uint32_t, kRateSources>, kEventCount> window_count{};
+};
+
+struct Registry {
+  std::mutex mutex;  // guards `rings` and serializes drains
+  std::vector<std::unique_ptr<LogRing>> rings;
+  std::string text;
+  std::FILE* sink = stdout;
+  std::array<double, kEventCount> rate_limit{};
+
+  std::atomic<uint64_t> written{0};
+  std::atomic<uint64_t> inline_drains{0};
+  std::atomic<uint64_t> dropped_rate{0};
+
+  std::thread drainer;
+  std::atomic<bool> background{false};
+  std::mutex wake_mutex;
+  std::condition_variable wake;
+  bool stop = false;
+
+  ~Registry();
+};
+
+Registry& registry() {
+  static Registry instance;
+  return instance;
+}
+
+LogRing& threadRing() {
+  thread_local LogRing* ring = nullptr;
+  if (!ring) {
+    auto owned = std::make_unique<LogRing>();
+    ring = owned.get();
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.rings.push_back(std::move(owned));
+  }
+  return *ring;
+}
+
+void appendField(const LogField& field, std::string& out) {
+  char buf[32];
+  int n = 0;
+  switch (field.kind) {
+    case LogField::INT:
+      n = std::snprintf(buf, sizeof(buf), "%lld", static_cast<long long>(field.i));
+      break;
+    case LogField::DOUBLE:
+      n = std::snprintf(buf, sizeof(buf), "%g", field.d);
+      break;
+    case LogField::STR:
+      out += field.s ? field.s : "";
+      return;
+  }
+  out.append(buf, static_cast<size_t>(n > 0 ? n : 0));
+}
+
+void format(const LogRecord& record, std::string& out) {
+  const size_t e = static_cast<size_t>(record.event);
+  if (e >= kEventCount) {
+    return;
+  }
+  size_t word_start = out.size();
+  size_t next = 0;
+  for (const char* c = kFormats[e]; *c; ++c) {
+    if (c[0] == '{' && c[1] == 't' && c[2] == '}') {
+      appendField(LogField(record.t_s), out);
+      c += 2;
+    } else if (c[0] == '{' && c[1] == '}') {
+      if (next == record.count) {
+        out.resize(word_start);
+        break;
+      }
+      appendField(record.fields[next++], out);
+      c += 1;
+    } else {
+      if (*c == ' ') {
+        word_start = out.size();
+      }
+      out += *c;
+    }
+  }
+  out += '\n';
+}
+
+void drainRings(Registry& reg) {
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  reg.text.clear();
+  uint64_t written = 0;
+  for (const auto& ring : reg.rings) {
+    size_t tail = ring->tail.load(std::memory_order_relaxed);
+    const size_t head = ring->head.load(std::memory_order_acquire);
+    for (; tail != head; ++tail, ++written) {
+      format(ring->records[tail & (kRingSize - 1)], reg.text);
+    }
+    ring->tail.store(tail, std::memory_order_release);
+  }
+  if (!reg.text.empty()) {
+    std::fwrite(reg.text.data(), 1, reg.text.size(), reg.sink);
+  }
+  reg.written.fetch_add(written, std::memory_order_relaxed);
+}
+
+void stopDrainer(Registry& reg) {
+  if (!reg.background.load()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(reg.wake_mutex);
+    reg.stop = true;
+  }
+  reg.wake.notify_all();
+  reg.drainer.join();
+  reg.background.store(false);
+}
+
+// Whatever is still buffered at exit is written out.
+Registry::~Registry() {
+  stopDrainer(*this);
+  drainRings(*this);
+  std::fflush(sink);
+}
+
+}  // namespace
+
+namespace event_log {
+
+void emit(LogEvent event, double t_s, std::initializer_list<LogField> fields) {
+  Registry& reg = registry();
+  LogRing& ring = threadRing();
+  const size_t e = static_cast<size_t>(event);
+  if (e >= kEventCount) {
+    return;
+  }
+
+  const double limit = reg.rate_limit[e];
+  if (limit > 0.0) {
+    // The source is the record's first integer field (the drone id for every drone
+    // event), so each drone gets its own quota instead of the first to tick taking it all.
+    size_t source = 0;
+    for (const LogField& field : fields) {
+      if (field.kind == LogField::INT) {
+        source = static_cast<size_t>(static_cast<uint64_t>(field.i) % kRateSources);
+        break;
+      }
+    }
+    const int64_t window = static_cast<int64_t>(std::floor(t_s));
+    if (ring.window[e][source] != window) {
+      ring.window[e][source] = window;
+      ring.window_count[e][source] = 0;
+    }
+    if (++ring.window_count[e][source] > limit) {
+      reg.dropped_rate.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+  }
+
+  const size_t head = ring.head.load(std::memory_order_relaxed);
+  if (head - ring.tail.load(std::memory_order_acquire) == kRingSize) {
+    reg.inline_drains.fetch_add(1, std::memory_order_relaxed);
+    drainRings(reg);
+  }
+
+  LogRecord& record = ring.records[head & (kRingSize - 1)];
+  record.t_s = t_s;
+  record.event = event;
+  record.count = 0;
+  for (const LogField& field : fields) {
+    if (record.count == kLogMaxFields) {
+      break;
+    }
+    record.fields[record.count++] = field;
+  }
+  ring.head.store(head + 1, std::memory_order_release);
+}
+
+void drain() {
+  drainRings(registry());
+}
+
+void setSink(std::FILE* sink) {
+  registry().sink = sink ? sink : stdout;
+}
+
+void setRateLimit(LogEvent event, double max_per_s) {
+  const size_t e = static_cast<size_t>(event);
+  if (e < kEventCount) {
+    registry().rate_limit[e] = max_per_s > 0.0 ? max_per_s : 0.0;
+  }
+}
+
+void startBackgroundDrain(std::chrono::milliseconds period) {
+  Registry& reg = registry();
+  if (reg.background.exchange(true)) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(reg.wake_mutex);
+    reg.stop = false;
+  }
+  reg.drainer = std::thread([&reg, period]() {
+    std::unique_lock<std::mutex> lock(reg.wake_mutex);
+    while (!reg.stop) {
+      reg.wake.wait_for(lock, period, [&reg]() { return reg.stop; });
+      lock.unlock();
+      drainRings(reg);
+      lock.lock();
+    }
+  });
+}
+
+void stopBackgroundDrain() {
+  Registry& reg = registry();
+  stopDrainer(reg);
+  drainRings(reg);
+  std::fflush(reg.sink);
+}
+
+EventLogStats stats() {
+  const Registry& reg = registry();
+  EventLogStats out;
+  out.written = reg.written.load(std::memory_order_relaxed);
+  out.inline_drains = reg.inline_drains.load(std::memory_order_relaxed);
+  out.dropped_rate = reg.dropped_rate.load(std::memory_order_relaxed);
+  return out;
+}
+
+}  // namespace event_log
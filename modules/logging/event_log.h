@@ -0,0 +1,108 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <initializer_list>
+
+// Structured event log.
+//
+// - Statements below SWARM_LOG_MIN_LEVEL are discarded at compile time, arguments included.
+// - Enabled statements append a fixed-size binary record (event id, sim time, typed fields)
+//   to the calling thread's lock-free single-producer ring; nothing is formatted there.
+// - Records are formatted and written (without flushing) only when drained, either by a
+//   background thread or by an explicit drain(). A producer that finds its ring full
+//   drains inline rather than dropping records.
+// - An optional per-event rate limit (records per simulated second) caps chatty events;
+//   it applies to each source (the record's first integer field, the drone id) separately.
+
+enum class LogLevel : uint8_t {
+  DEBUG = 0,
+  INFO = 1,
+  WARN = 2,
+  OFF = 3,
+};
+
+#ifndef SWARM_LOG_MIN_LEVEL
+#define SWARM_LOG_MIN_LEVEL 1  // INFO
+#endif
+
+enum class LogEvent : uint16_t {
+  MISSION_START = 0,
+  REPOSITION,
+  HELP_PROXY_TX,
+  HELP_PROXY_RX,
+  RELAYED_ACK_RX,
+  COUNT,
+};
+
+constexpr size_t kLogMaxFields = 9;
+
+struct LogField {
+  enum Kind : uint8_t { INT, DOUBLE, STR };
+
+  Kind kind;
+  union {
+    int64_t i;
+    double d;
+    const char* s;  // must have static storage duration (e.g. a literal)
+  };
+
+  LogField() : kind(INT), i(0) {}
+  LogField(int v) : kind(INT), i(v) {}
+  LogField(unsigned v) : kind(INT), i(v) {}
+  LogField(long v) : kind(INT), i(v) {}
+  LogField(unsigned long v) : kind(INT), i(static_cast<int64_t>(v)) {}
+  LogField(long long v) : kind(INT), i(v) {}
+  LogField(unsigned long long v) : kind(INT), i(static_cast<int64_t>(v)) {}
+  LogField(double v) : kind(DOUBLE), d(v) {}
+  LogField(float v) : kind(DOUBLE), d(v) {}
+  LogField(const char* v) : kind(STR), s(v) {}
+};
+
+struct LogRecord {
+  double t_s = 0.0;
+  LogEvent event = LogEvent::COUNT;
+  uint8_t count = 0;
+  std::array<LogField, kLogMaxFields> fields;
+};
+
+struct EventLogStats {
+  uint64_t written = 0;
+  uint64_t inline_drains = 0;  // producer found its ring full
+  uint64_t dropped_rate = 0;   // over the event's per-source rate limit
+};
+
+namespace event_log {
+
+// Appends a record to this thread's ring. Use SWARM_LOG so disabled levels compile away.
+void emit(LogEvent event, double t_s, std::initializer_list<LogField> fields);
+
+// Formats and writes every pending record of every thread to the sink.
+void drain();
+
+// Where drained text goes (default stdout). Set before logging starts.
+void setSink(std::FILE* sink);
+
+// At most `max_per_s` records of `event` per simulated second from each source, i.e. each
+// value of the first integer field (0: unlimited). Set before logging starts.
+void setRateLimit(LogEvent event, double max_per_s);
+
+// Drains every `period` on a background thread until stopBackgroundDrain(), which also
+// drains what is left and flushes the sink.
+void startBackgroundDrain(std::chrono::milliseconds period = std::chrono::milliseconds(50));
+void stopBackgroundDrain();
+
+EventLogStats stats();
+
+}  // namespace event_log
+
+#define SWARM_LOG(level, event, t_s, ...)                                                          \
+  do {                                                                                             \
+    if constexpr (static_cast<int>(LogLevel::level) >= SWARM_LOG_MIN_LEVEL) {                      \
+      ::event_log::emit(LogEvent::event, (t_s), {__VA_ARGS__});                                    \
+    }                                                                                              \
+  } while (0)
@@ -0,0 +1,149 @@
+#include "modules/logging/trajectory_trace.h"
+
+#include <algorithm>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+namespace {
+
+constexpr char kMagic[8] = {'S', 'W', 'T', 'R', 'A', 'C', 'E', '1'};
+constexpr uint32_t kColumnCount = 7;
+
+template <typename T>
+void writeValue(std::ostream& out, const T& value) {
+  out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+void writeColumn(std::ostream& out, const T* values, size_t n) {
+  out.write(reinterpret_cast<const char*>(values), static_cast<std::streamsize>(n * sizeof(T)));
+}
+
+template <typename T>
+bool readValue(std::istream& in, T& value) {
+  return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+template <typename T>
+bool readColumn(std::istream& in, std::vector<T>& values, size_t n) {
+  values.resize(n);
+  return static_cast<bool>(in.read(reinterpret_cast<char*>(values.data()), static_cast<std::streamsize>(n * sizeof(T))));
+}
+
+}  // namespace
+
+TrajectoryTrace::TrajectoryTrace() : m_block(std::make_unique<Block>()) {}
+
+TrajectoryTrace::~TrajectoryTrace() {
+  close();
+}
+
+bool TrajectoryTrace::open(const std::string& path) {
+  close();
+  m_out.open(path, std::ios::binary | std::ios::trunc);
+  if (!m_out.good()) {
+    m_out.close();
+    return false;
+  }
+  m_out.write(kMagic, sizeof(kMagic));
+  writeValue(m_out, static_cast<uint32_t>(kBlockSamples));
+  writeValue(m_out, kColumnCount);
+  m_pending = 0;
+  m_samples = 0;
+  return m_out.good();
+}
+
+void TrajectoryTrace::append(double t_s, uint8_t drone, uint8_t hops, size_t neighbors, const Vector3D& position) {
+  if (!m_out.is_open()) {
+    return;
+  }
+  Block& block = *m_block;
+  block.t[m_pending] = t_s;
+  block.drone[m_pending] = drone;
+  block.hops[m_pending] = hops;
+  block.neighbors[m_pending] = static_cast<uint16_t>(std::min<size_t>(neighbors, UINT16_MAX));
+  block.x[m_pending] = static_cast<float>(position.x);
+  block.y[m_pending] = static_cast<float>(position.y);
+  block.z[m_pending] = static_cast<float>(position.z);
+  ++m_samples;
+  if (++m_pending == kBlockSamples) {
+    writeBlock();
+  }
+}
+
+void TrajectoryTrace::close() {
+  if (!m_out.is_open()) {
+    return;
+  }
+  writeBlock();
+  m_out.close();
+}
+
+void TrajectoryTrace::writeBlock() {
+  if (m_pending == 0) {
+    return;
+  }
+  const Block& block = *m_block;
+  writeValue(m_out, static_cast<uint32_t>(m_pending));
+  writeColumn(m_out, block.t.data(), m_pending);
+  writeColumn(m_out, block.drone.data(), m_pending);
+  writeColumn(m_out, block.hops.data(), m_pending);
+  writeColumn(m_out, block.neighbors.data(), m_pending);
+  writeColumn(m_out, block.x.data(), m_pending);
+  writeColumn(m_out, block.y.data(), m_pending);
+  writeColumn(m_out, block.z.data(), m_pending);
+  m_pending = 0;
+}
+
+bool trajectoryTraceToCsv(std::istream& in, std::ostream& out) {
+  char magic[sizeof(kMagic)];
+  uint32_t block_samples = 0;
+  uint32_t column_count = 0;
+  if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 ||
+      !readValue(in, block_samples) || !readValue(in, column_count) || column_count != kColumnCount) {
+    return false;
+  }
+
+  out << "t,drone,hops,neighbors,x,y,z\n";
+
+  std::vector<double> t;
+  std::vector<uint8_t> drone;
+  std::vector<uint8_t> hops;
+  std::vector<uint16_t> neighbors;
+  std::vector<float> x;
+  std::vector<float> y;
+  std::vector<float> z;
+  uint32_t n = 0;
+  while (readValue(in, n)) {
+    if (n == 0 || n > block_samples) {
+      return false;
+    }
+    if (!readColumn(in, t, n) || !readColumn(in, drone, n) || !readColumn(in, hops, n) ||
+        !readColumn(in, neighbors, n) || !readColumn(in, x, n) || !readColumn(in, y, n) ||
+        !readColumn(in, z, n)) {
+      return false;
+    }
+    for (uint32_t i = 0; i < n; ++i) {
+      out << t[i] << ","
+          << static_cast<int>(drone[i]) << ","
+          << static_cast<int>(hops[i]) << ","
+          << neighbors[i] << ","
+          << static_cast<double>(x[i]) << ","
+          << static_cast<double>(y[i]) << ","
+          << static_cast<double>(z[i]) << "\n";
+    }
+  }
+  // A clean end of file falls exactly between blocks.
+  return in.eof() && in.gcount() == 0 && out.good();
+}
+
+bool trajectoryTraceToCsv(const std::string& trace_path, const std::string& csv_path) {
+  std::ifstream in(trace_path, std::ios::binary);
+  std::ofstream out(csv_path);
+  if (!in.good() || !out.good()) {
+    return false;
+  }
+  return trajectoryTraceToCsv(in, out);
+}
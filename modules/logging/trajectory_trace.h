@@ -0,0 +1,66 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iosfwd>
+#include <memory>
+#include <string>
+
+#include "common/vector3D.h"
+
+// Columnar binary trace of drone trajectory samples (t, drone, hops, neighbors, x, y, z).
+//
+// Samples are appended to fixed-size column blocks and written one block at a time, so
+// recording costs a few stores per sample and one write per kBlockSamples samples.
+// File layout (host byte order, little-endian on every supported target):
+//   header: char magic[8] = "SWTRACE1", uint32 block_samples, uint32 column_count (7)
+//   blocks: uint32 n (1..block_samples), then each column's n values back to back:
+//           t f64, drone u8, hops u8, neighbors u16, x f32, y f32, z f32
+// Not thread-safe; drones of one simulation share a trace on the simulator thread.
+class TrajectoryTrace {
+ public:
+  static constexpr size_t kBlockSamples = 4096;
+
+  TrajectoryTrace();
+  ~TrajectoryTrace();
+
+  TrajectoryTrace(const TrajectoryTrace&) = delete;
+  TrajectoryTrace& operator=(const TrajectoryTrace&) = delete;
+
+  // Creates `path` and writes the header. Returns false if it cannot be written.
+  bool open(const std::string& path);
+  bool isOpen() const { return m_out.is_open(); }
+
+  // Neighbor counts above UINT16_MAX are saturated.
+  void append(double t_s, uint8_t drone, uint8_t hops, size_t neighbors, const Vector3D& position);
+
+  // Writes the pending partial block and closes the file.
+  void close();
+
+  uint64_t samples() const { return m_samples; }
+
+ private:
+  struct Block {
+    std::array<double, kBlockSamples> t;
+    std::array<uint8_t, kBlockSamples> drone;
+    std::array<uint8_t, kBlockSamples> hops;
+    std::array<uint16_t, kBlockSamples> neighbors;
+    std::array<float, kBlockSamples> x;
+    std::array<float, kBlockSamples> y;
+    std::array<float, kBlockSamples> z;
+  };
+
+  void writeBlock();
+
+  std::ofstream m_out;
+  std::unique_ptr<Block> m_block;
+  size_t m_pending = 0;
+  uint64_t m_samples = 0;
+};
+
+// Rewrites a trace as the CSV the simulator used to write directly
+// ("t,drone,hops,neighbors,x,y,z"). Returns false on a malformed or truncated trace.
+bool trajectoryTraceToCsv(std::istream& in, std::ostream& out);
+bool trajectoryTraceToCsv(const std::string& trace_path, const std::string& csv_path);
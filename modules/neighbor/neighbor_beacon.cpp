@@ -0,0 +1,169 @@
+#include "modules/neighbor/neighbor_beacon.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "modules/neighbor/neighbor_info.h"
+
+namespace {
+
+bool quantize(double value, double origin, double resolution, int32_t& out) {
+    const double q = std::round((value - origin) / resolution);
+    if (!(q >= std::numeric_limits<int16_t>::min() && q <= std::numeric_limits<int16_t>::max())) {
+        return false;
+    }
+    out = static_cast<int32_t>(q);
+    return true;
+}
+
+int16_t quantizeVelocity(double value, double resolution) {
+    const double q = std::round(value / resolution);
+    return static_cast<int16_t>(std::clamp<double>(q, std::numeric_limits<int16_t>::min(), std::numeric_limits<int16_t>::max()));
+}
+
+bool fitsInt8(int32_t value) {
+    return value >= std::numeric_limits<int8_t>::min() && value <= std::numeric_limits<int8_t>::max();
+}
+
+}  // namespace
+
+void NeighborBeaconEncoder::setConfig(const NeighborBeaconConfig& config) {
+    m_config = config;
+    m_has_prev = false;
+}
+
+EncodedBeacon NeighborBeaconEncoder::encode(
+    uint8_t id,
+    uint8_t hops,
+    Vector3D position,
+    Vector3D velocity,
+    ::PacketPayload& out
+) {
+    std::array<int32_t, 3> q{};
+    bool in_range = m_config.compact && m_config.resolution_m > 0.0;
+    in_range = in_range && quantize(position.x, m_config.origin_x, m_config.resolution_m, q[0]) &&
+               quantize(position.y, m_config.origin_y, m_config.resolution_m, q[1]) &&
+               quantize(position.z, m_config.origin_z, m_config.resolution_m, q[2]);
+
+    EncodedBeacon encoded;
+    if (!in_range) {
+        NeighborInfo(id, hops, position).serialize(out);
+        m_has_prev = false;
+        return encoded;
+    }
+    encoded.compact = true;
+
+    CompactBeaconHeader header;
+    header.neighbor_id = id;
+    header.hops = hops;
+    header.seq = ++m_seq;
+    const bool with_velocity = m_config.velocity && m_config.velocity_resolution_mps > 0.0;
+    if (with_velocity) {
+        header.flags |= BEACON_VELOCITY;
+    }
+
+    const std::array<int32_t, 3> d = {q[0] - m_prev[0], q[1] - m_prev[1], q[2] - m_prev[2]};
+    const bool use_delta = m_config.delta && m_has_prev && m_since_keyframe + 1 < m_config.keyframe_interval &&
+                           fitsInt8(d[0]) && fitsInt8(d[1]) && fitsInt8(d[2]);
+    if (use_delta) {
+        CompactBeaconDelta msg;
+        msg.header = header;
+        msg.header.flags |= BEACON_DELTA;
+        msg.dx = static_cast<int8_t>(d[0]);
+        msg.dy = static_cast<int8_t>(d[1]);
+        msg.dz = static_cast<int8_t>(d[2]);
+        out.resize(sizeof(msg));
+        std::memcpy(out.data(), &msg, sizeof(msg));
+        ++m_since_keyframe;
+    } else {
+        CompactBeaconAbsolute msg;
+        msg.header = header;
+        msg.x = static_cast<int16_t>(q[0]);
+        msg.y = static_cast<int16_t>(q[1]);
+        msg.z = static_cast<int16_t>(q[2]);
+        out.resize(sizeof(msg));
+        std::memcpy(out.data(), &msg, sizeof(msg));
+        m_since_keyframe = 0;
+    }
+
+    if (with_velocity) {
+        CompactBeaconVelocity block;
+        block.vx = quantizeVelocity(velocity.x, m_config.velocity_resolution_mps);
+        block.vy = quantizeVelocity(velocity.y, m_config.velocity_resolution_mps);
+        block.vz = quantizeVelocity(velocity.z, m_config.velocity_resolution_mps);
+        const size_t offset = out.size();
+        out.resize(offset + sizeof(block));
+        std::memcpy(out.data() + offset, &block, sizeof(block));
+        encoded.has_velocity = true;
+        encoded.velocity = Vector3D(block.vx, block.vy, block.vz) * m_config.velocity_resolution_mps;
+    }
+
+    m_prev = q;
+    m_has_prev = true;
+    return encoded;
+}
+
+void NeighborBeaconDecoder::setConfig(const NeighborBeaconConfig& config) {
+    m_config = config;
+    m_has_ref.reset();
+}
+
+bool NeighborBeaconDecoder::isLegacy(std::span<const uint8_t> payload) {
+    return payload.size() >= 2 && (payload.size() - 2) % sizeof(double) == 0;
+}
+
+bool NeighborBeaconDecoder::decode(std::span<const uint8_t> payload, DecodedBeacon& out) {
+    if (payload.size() < sizeof(CompactBeaconHeader)) {
+        return false;
+    }
+    CompactBeaconHeader header;
+    std::memcpy(&header, payload.data(), sizeof(header));
+    if (header.version != NEIGHBOR_BEACON_VERSION) {
+        return false;
+    }
+
+    std::array<int32_t, 3>& ref = m_ref[header.neighbor_id];
+    const size_t position_size = (header.flags & BEACON_DELTA) ? sizeof(CompactBeaconDelta) : sizeof(CompactBeaconAbsolute);
+    const bool with_velocity = (header.flags & BEACON_VELOCITY) != 0;
+    if (payload.size() < position_size + (with_velocity ? sizeof(CompactBeaconVelocity) : 0)) {
+        return false;
+    }
+
+    if (header.flags & BEACON_DELTA) {
+        // A delta is only meaningful on top of the beacon right before it.
+        if (!m_has_ref.test(header.neighbor_id) || static_cast<uint8_t>(m_ref_seq[header.neighbor_id] + 1) != header.seq) {
+            m_has_ref.reset(header.neighbor_id);
+            return false;
+        }
+        CompactBeaconDelta msg;
+        std::memcpy(&msg, payload.data(), sizeof(msg));
+        ref[0] += msg.dx;
+        ref[1] += msg.dy;
+        ref[2] += msg.dz;
+    } else {
+        CompactBeaconAbsolute msg;
+        std::memcpy(&msg, payload.data(), sizeof(msg));
+        ref = {msg.x, msg.y, msg.z};
+        m_has_ref.set(header.neighbor_id);
+    }
+    m_ref_seq[header.neighbor_id] = header.seq;
+
+    out.neighbor_id = header.neighbor_id;
+    out.hops = header.hops;
+    out.x = m_config.origin_x + ref[0] * m_config.resolution_m;
+    out.y = m_config.origin_y + ref[1] * m_config.resolution_m;
+    out.z = m_config.origin_z + ref[2] * m_config.resolution_m;
+    out.velocity = Vector3D(0.0, 0.0, 0.0);
+    if (with_velocity) {
+        CompactBeaconVelocity block;
+        std::memcpy(&block, payload.data() + position_size, sizeof(block));
+        out.velocity = Vector3D(
+            block.vx * m_config.velocity_resolution_mps,
+            block.vy * m_config.velocity_resolution_mps,
+            block.vz * m_config.velocity_resolution_mps
+        );
+    }
+    return true;
+}
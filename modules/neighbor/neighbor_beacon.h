@@ -0,0 +1,135 @@
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <span>
+
+#include "common/packet_payload.h"
+#include "common/vector3D.h"
+
+// Compact neighbor beacon wire format (version 1).
+//
+// Legacy beacons are [id][hops][double coords...], i.e. 2 + 8k bytes. Compact beacons
+// start with the same [id][hops] and then an explicit version byte; their sizes (11 and
+// 8 bytes, 17 and 14 with velocity) are never 2 + 8k, so a receiver tells the two apart
+// by length alone.
+//
+// Positions are fixed point relative to a swarm-wide origin: int16 per axis at
+// `resolution_m` (1 cm covers +-327 m). A delta beacon carries int8 offsets from the
+// sender's previous beacon and is only applied if the receiver decoded that beacon
+// (seq - 1); otherwise it is dropped and the next absolute keyframe resynchronizes.
+// With BEACON_VELOCITY set, an int16-per-axis velocity block (at `velocity_resolution_mps`)
+// follows the position; decoders that predate it ignore the trailing bytes.
+
+constexpr uint8_t NEIGHBOR_BEACON_VERSION = 1;
+
+enum NeighborBeaconFlags : uint8_t {
+  BEACON_DELTA = 0x01,
+  BEACON_VELOCITY = 0x02,
+};
+
+#pragma pack(push, 1)
+
+struct CompactBeaconHeader {
+  uint8_t neighbor_id;
+  uint8_t hops;
+  uint8_t version = NEIGHBOR_BEACON_VERSION;
+  uint8_t flags = 0;
+  uint8_t seq;
+};
+
+struct CompactBeaconAbsolute {
+  CompactBeaconHeader header;
+  int16_t x;
+  int16_t y;
+  int16_t z;
+};
+
+struct CompactBeaconDelta {
+  CompactBeaconHeader header;
+  int8_t dx;
+  int8_t dy;
+  int8_t dz;
+};
+
+struct CompactBeaconVelocity {
+  int16_t vx;
+  int16_t vy;
+  int16_t vz;
+};
+
+#pragma pack(pop)
+
+static_assert(sizeof(CompactBeaconAbsolute) == 11, "CompactBeaconAbsolute must be packed");
+static_assert(sizeof(CompactBeaconDelta) == 8, "CompactBeaconDelta must be packed");
+static_assert((sizeof(CompactBeaconAbsolute) - 2) % sizeof(double) != 0, "must not look like a legacy beacon");
+static_assert((sizeof(CompactBeaconDelta) - 2) % sizeof(double) != 0, "must not look like a legacy beacon");
+static_assert((sizeof(CompactBeaconAbsolute) + sizeof(CompactBeaconVelocity) - 2) % sizeof(double) != 0,
+              "must not look like a legacy beacon");
+static_assert((sizeof(CompactBeaconDelta) + sizeof(CompactBeaconVelocity) - 2) % sizeof(double) != 0,
+              "must not look like a legacy beacon");
+
+// Must match across the swarm (sender quantizes, receivers dequantize).
+struct NeighborBeaconConfig {
+  bool compact = true;             // false: send legacy double beacons
+  double origin_x = 0.0;
+  double origin_y = 0.0;
+  double origin_z = 0.0;
+  double resolution_m = 0.01;
+  bool delta = false;              // send int8 deltas between absolute keyframes
+  uint8_t keyframe_interval = 10;  // an absolute beacon at least every N beacons
+  bool velocity = true;            // append the sender's velocity (for dead reckoning)
+  double velocity_resolution_mps = 0.01;
+};
+
+struct DecodedBeacon {
+  uint8_t neighbor_id = 0;
+  uint8_t hops = 0;
+  double x = 0.0;
+  double y = 0.0;
+  double z = 0.0;
+  Vector3D velocity{0.0, 0.0, 0.0};  // zero for beacons without a velocity block
+};
+
+// What encode() put on the wire, as receivers will decode it.
+struct EncodedBeacon {
+  bool compact = false;              // false: legacy fallback
+  bool has_velocity = false;
+  Vector3D velocity{0.0, 0.0, 0.0};  // quantized; zero without a velocity block
+};
+
+// Sender side: one per node, remembers the previous beacon for delta encoding.
+class NeighborBeaconEncoder {
+ public:
+  void setConfig(const NeighborBeaconConfig& config);
+
+  // Writes a compact beacon, or a legacy one if the position is outside the
+  // quantization range (or compact encoding is off).
+  EncodedBeacon encode(uint8_t id, uint8_t hops, Vector3D position, Vector3D velocity, ::PacketPayload& out);
+
+ private:
+  NeighborBeaconConfig m_config;
+  bool m_has_prev = false;
+  std::array<int32_t, 3> m_prev{};
+  uint8_t m_seq = 0;
+  uint8_t m_since_keyframe = 0;
+};
+
+// Receiver side: keeps each sender's last decoded position as the delta reference.
+class NeighborBeaconDecoder {
+ public:
+  void setConfig(const NeighborBeaconConfig& config);
+
+  // Returns false for unknown versions, short payloads and deltas without a reference.
+  bool decode(std::span<const uint8_t> payload, DecodedBeacon& out);
+
+  // True if `payload` has the length of a legacy [id][hops][double...] beacon.
+  static bool isLegacy(std::span<const uint8_t> payload);
+
+ private:
+  NeighborBeaconConfig m_config;
+  std::bitset<256> m_has_ref;
+  std::array<std::array<int32_t, 3>, 256> m_ref{};
+  std::array<uint8_t, 256> m_ref_seq{};
+};
@@ -1,6 +1,7 @@
 #pragma once
+#include <algorithm>
 #include <cstdint>
-#include <vector>
+#include <span>
 #include <cstring>
 #include <stdexcept>
 
@@ -15,16 +16,16 @@ class NeighborInfo : public NeighborInfoInterface {
         NeighborInfo(
             uint8_t id,
             uint8_t hops,
-            const std::vector<double>& coordinates
+            Vector3D coordinates
         );
 
-        std::vector<double> getPosition() const override;
+        Vector3D getPosition() const override;
         uint8_t getHopsToBaseStation() const override;
-        void serialize(std::vector<uint8_t>& out_payload) const override;
-        void deserialize(const std::vector<uint8_t>& in_payload) override;
+        void serialize(::PacketPayload& out_payload) const override;
+        void deserialize(std::span<const uint8_t> in_payload) override;
 
     private:
         uint8_t neighbor_id;
         uint8_t hops_from_base_station;
-        std::vector<double> position;
+        Vector3D position;
 };
\ No newline at end of file
@@ -1,12 +1,75 @@
 #include "modules/neighbor/neighbor_manager.h"
 
+#include <algorithm>
+#include <cmath>
+
 NeighborManager::NeighborManager(
     CommunicationManagerInterface* communication_manager
 ) : 
     m_communication_manager(communication_manager) 
 { }
 
-void NeighborManager::onPacketReceived(const ::Packet& pkt) {
+void NeighborManager::setBeaconListener(BeaconListener listener) {
+    m_beacon_listener = std::move(listener);
+}
+
+void NeighborManager::setClock(Clock clock) {
+    m_clock = std::move(clock);
+}
+
+void NeighborManager::setPrediction(const NeighborPredictionConfig& config) {
+    m_prediction = config;
+}
+
+void NeighborManager::setBeaconRate(const AdaptiveRateConfig& config) {
+    m_beacon_rate.setConfig(config);
+}
+
+void NeighborManager::setMissionActive(bool active) {
+    m_mission_active = active;
+}
+
+void NeighborManager::setBeaconFormat(const NeighborBeaconConfig& config) {
+    m_beacon_encoder.setConfig(config);
+    m_beacon_decoder.setConfig(config);
+}
+
+void NeighborManager::setAging(const NeighborAgingConfig& config) {
+    m_aging = config;
+    if (m_aging.ttl_s <= 0.0) {
+        for (size_t id = 0; id < m_slot_of.size(); ++id) {
+            m_wheel.cancel(static_cast<uint8_t>(id));
+        }
+    }
+}
+
+void NeighborManager::advance(double now_s) {
+    m_now_s = now_s;
+    if (m_aging.tick_s <= 0.0) {
+        extrapolate(now_s);
+        return;
+    }
+    // The epsilon keeps times that are exact multiples of tick_s on their own tick.
+    const auto now_tick = static_cast<uint64_t>(std::floor(now_s / m_aging.tick_s + 1e-9));
+    m_wheel.advance(now_tick, [this](uint8_t neighbor_id) {
+        if (m_present.test(neighbor_id)) {
+            remove(neighbor_id);
+            ++m_aging_stats.expired;
+        }
+    });
+    extrapolate(now_s);
+}
+
+void NeighborManager::extrapolate(double now_s) {
+    for (size_t i = 0; i < m_count; ++i) {
+        const double dt = std::clamp(now_s - m_last_heard_s[i], 0.0, m_prediction.max_extrapolation_s);
+        m_x[i] = m_bx[i] + m_vx[i] * dt;
+        m_y[i] = m_by[i] + m_vy[i] * dt;
+        m_z[i] = m_bz[i] + m_vz[i] * dt;
+    }
+}
+
+void NeighborManager::onPacketReceived(const ::PacketView& pkt) {
     if (pkt.type != ::PacketType::NEIGHBOR) {
         return;
     }
@@ -14,35 +77,92 @@ void NeighborManager::onPacketReceived(const ::Packet& pkt) {
         return;
     }
 
-    // Payload format: [neighbor_id][hops][double coords...]
+    // Both formats start with [neighbor_id][hops].
     const uint8_t neighbor_id = pkt.payload[0];
     if (neighbor_id != pkt.src) {
         // Basic sanity check: outer header src should match payload id.
         return;
     }
 
-    const uint8_t hops = pkt.payload[1];
-    const size_t coord_bytes = pkt.payload.size() - 2;
-    if (coord_bytes % sizeof(double) != 0) {
+    DecodedBeacon beacon;
+    if (NeighborBeaconDecoder::isLegacy(pkt.payload)) {
+        // Legacy payload: [neighbor_id][hops][double coords...]; missing trailing coordinates read as 0.
+        const size_t coord_bytes = pkt.payload.size() - 2;
+        double coords[3] = {0.0, 0.0, 0.0};
+        std::memcpy(coords, pkt.payload.data() + 2, std::min(coord_bytes, sizeof(coords)));
+        beacon.neighbor_id = neighbor_id;
+        beacon.hops = pkt.payload[1];
+        beacon.x = coords[0];
+        beacon.y = coords[1];
+        beacon.z = coords[2];
+    } else if (!m_beacon_decoder.decode(pkt.payload, beacon)) {
         return;
     }
 
-    std::vector<double> coords;
-    coords.resize(coord_bytes / sizeof(double));
-    if (coord_bytes > 0) {
-        std::memcpy(coords.data(), pkt.payload.data() + 2, coord_bytes);
+    const uint8_t hops = beacon.hops;
+    upsert(beacon, now());
+
+    // Refreshing an entry just moves it to a later wheel slot.
+    if (m_aging.ttl_s > 0.0 && m_aging.tick_s > 0.0) {
+        const auto ttl_ticks = static_cast<uint64_t>(std::ceil(m_aging.ttl_s / m_aging.tick_s - 1e-9));
+        m_wheel.schedule(neighbor_id, m_wheel.currentTick() + ttl_ticks);
     }
 
-    m_neighbors[neighbor_id] = std::make_unique<NeighborInfo>(neighbor_id, hops, coords);
+    if (m_beacon_listener) {
+        m_beacon_listener(neighbor_id, hops);
+    }
 }
  
-std::vector<NeighborInfoInterface*> NeighborManager::getNeighbors() const {
-    std::vector<NeighborInfoInterface*> neighbors;
-    neighbors.reserve(m_neighbors.size());
-    for (const auto& kv : m_neighbors) {
-        neighbors.push_back(kv.second.get());
+NeighborSpan NeighborManager::neighbors() const {
+    NeighborSpan view;
+    view.ids = std::span<const uint8_t>(m_ids.data(), m_count);
+    view.x = std::span<const double>(m_x.data(), m_count);
+    view.y = std::span<const double>(m_y.data(), m_count);
+    view.z = std::span<const double>(m_z.data(), m_count);
+    view.hops = std::span<const uint8_t>(m_hops.data(), m_count);
+    return view;
+}
+
+void NeighborManager::upsert(const DecodedBeacon& beacon, double now_s) {
+    const uint8_t neighbor_id = beacon.neighbor_id;
+    if (!m_present.test(neighbor_id)) {
+        m_present.set(neighbor_id);
+        m_slot_of[neighbor_id] = static_cast<uint8_t>(m_count);
+        m_ids[m_count] = neighbor_id;
+        ++m_count;
     }
-    return neighbors;
+
+    const size_t slot = m_slot_of[neighbor_id];
+    m_x[slot] = m_bx[slot] = beacon.x;
+    m_y[slot] = m_by[slot] = beacon.y;
+    m_z[slot] = m_bz[slot] = beacon.z;
+    m_vx[slot] = beacon.velocity.x;
+    m_vy[slot] = beacon.velocity.y;
+    m_vz[slot] = beacon.velocity.z;
+    m_hops[slot] = beacon.hops;
+    m_last_heard_s[slot] = now_s;
+}
+
+void NeighborManager::remove(uint8_t neighbor_id) {
+    const size_t slot = m_slot_of[neighbor_id];
+    const size_t last = --m_count;
+    if (slot != last) {
+        const uint8_t moved_id = m_ids[last];
+        m_ids[slot] = moved_id;
+        m_x[slot] = m_x[last];
+        m_y[slot] = m_y[last];
+        m_z[slot] = m_z[last];
+        m_bx[slot] = m_bx[last];
+        m_by[slot] = m_by[last];
+        m_bz[slot] = m_bz[last];
+        m_vx[slot] = m_vx[last];
+        m_vy[slot] = m_vy[last];
+        m_vz[slot] = m_vz[last];
+        m_hops[slot] = m_hops[last];
+        m_last_heard_s[slot] = m_last_heard_s[last];
+        m_slot_of[moved_id] = static_cast<uint8_t>(slot);
+    }
+    m_present.reset(neighbor_id);
 }
 
 void NeighborManager::sendToNeighbors(
@@ -54,14 +174,49 @@ void NeighborManager::sendToNeighbors(
         return;
     }
 
-    const std::vector<double> coords = position->getCoordinates();
-    NeighborInfo info(id, hops_to_base_station, coords);
+    const Vector3D coords = position->getCoordinates();
+    const Vector3D velocity = position->getVelocity();
+    const double now_s = now();
+
+    double accel_mps2 = 0.0;
+    if (m_has_prev_velocity && now_s > m_prev_velocity_s) {
+        accel_mps2 = (velocity - m_prev_velocity).module() / (now_s - m_prev_velocity_s);
+    }
+    m_has_prev_velocity = true;
+    m_prev_velocity_s = now_s;
+    m_prev_velocity = velocity;
+
+    // Skip the beacon while neighbors' extrapolation of our last one is still accurate.
+    // A legacy-fallback beacon never suppresses the next one.
+    if (m_prediction.divergence_threshold_m > 0.0 && m_has_sent && m_sent_compact &&
+        hops_to_base_station == m_sent_hops && (now_s - m_sent_s) < m_prediction.keepalive_s) {
+        const double dt = std::min(now_s - m_sent_s, m_prediction.max_extrapolation_s);
+        const Vector3D error = coords - (m_sent_coords + m_sent_velocity * dt);
+        if (error.module() <= m_prediction.divergence_threshold_m) {
+            ++m_beacon_stats.suppressed;
+            return;
+        }
+    }
+
+    const bool hops_changed = !m_has_sent || hops_to_base_station != m_sent_hops;
+    if (!m_beacon_rate.shouldSend(now_s, velocity.module(), accel_mps2, m_mission_active, hops_changed)) {
+        ++m_beacon_stats.rate_limited;
+        return;
+    }
 
     ::Packet pkt;
     pkt.type = ::PacketType::NEIGHBOR;
     pkt.src = id;
     pkt.dst = BROADCAST_ID;
-    info.serialize(pkt.payload);
+    const EncodedBeacon encoded = m_beacon_encoder.encode(id, hops_to_base_station, coords, velocity, pkt.payload);
 
     m_communication_manager->send(pkt);
+    ++m_beacon_stats.sent;
+    m_has_sent = true;
+    m_sent_s = now_s;
+    m_sent_hops = hops_to_base_station;
+    m_sent_coords = coords;
+    // Receivers extrapolate with what was on the wire, not with our true velocity.
+    m_sent_compact = encoded.compact;
+    m_sent_velocity = encoded.velocity;
 }
\ No newline at end of file
@@ -1,25 +1,145 @@
 #pragma once
 
+#include <array>
+#include <bitset>
 #include <cstdint>
-#include <memory>
-#include <unordered_map>
+#include <functional>
 #include <cstring>
 
 #include "interfaces/communication_manager.h"
 #include "interfaces/neighbor_manager.h"
 #include "interfaces/position.h"
 
+#include "common/adaptive_rate.h"
+
+#include "modules/neighbor/neighbor_beacon.h"
 #include "modules/neighbor/neighbor_info.h"
+#include "modules/neighbor/neighbor_timing_wheel.h"
+
+// Entries not refreshed by a beacon for `ttl_s` are dropped (ttl_s <= 0 keeps them forever).
+// Time advances in steps of `tick_s`, the owner's control period.
+struct NeighborAgingConfig {
+  double ttl_s = 1.0;
+  double tick_s = 0.05;
+};
+
+struct NeighborAgingStats {
+  uint64_t expired = 0;  // entries removed because their TTL ran out
+};
+
+// Dead reckoning. Receivers extrapolate each neighbor along its beaconed velocity, for at
+// most `max_extrapolation_s`. Senders skip a beacon while their true position stays within
+// `divergence_threshold_m` of that extrapolation, their hop count is unchanged and less than
+// `keepalive_s` has passed (threshold 0 = beacon on every call). Keep keepalive_s below
+// the receivers' aging TTL.
+struct NeighborPredictionConfig {
+  double divergence_threshold_m = 0.0;
+  double keepalive_s = 0.5;
+  double max_extrapolation_s = 1.0;
+};
+
+struct NeighborBeaconStats {
+  uint64_t sent = 0;
+  uint64_t suppressed = 0;  // beacons skipped because neighbors' prediction was still good
+  uint64_t rate_limited = 0;  // beacons skipped by the motion-adaptive rate
+};
 
 class NeighborManager : public NeighborManagerInterface {
  public:
+  // Called for every accepted beacon, after the table is updated.
+  using BeaconListener = std::function<void(uint8_t neighbor_id, uint8_t hops_to_base_station)>;
+  using Clock = std::function<double()>;
+
   explicit NeighborManager(CommunicationManagerInterface* communication_manager);
 
-  void onPacketReceived(const ::Packet& pkt) override;
-  std::vector<NeighborInfoInterface*> getNeighbors() const override;
+  void setBeaconListener(BeaconListener listener);
+
+  // Timestamps beacons on receipt; without a clock the time of the last advance() is used.
+  void setClock(Clock clock);
+
+  void setPrediction(const NeighborPredictionConfig& config);
+
+  // Motion-adaptive beacon rate: speed comes from the position, acceleration from the
+  // change in velocity between calls; a hop change always goes out immediately.
+  void setBeaconRate(const AdaptiveRateConfig& config);
+  void setMissionActive(bool active);
+  const NeighborBeaconStats& beaconStats() const { return m_beacon_stats; }
+
+  // Outgoing beacon encoding; incoming beacons are accepted in any format.
+  void setBeaconFormat(const NeighborBeaconConfig& config);
+
+  void setAging(const NeighborAgingConfig& config);
+  const NeighborAgingStats& agingStats() const { return m_aging_stats; }
+
+  // Advances the aging clock, drops expired entries and extrapolates the remaining ones
+  // to `now_s`. Aging costs O(1) per tick plus O(1) per expired entry, independent of
+  // the table size.
+  void advance(double now_s);
+
+  bool contains(uint8_t neighbor_id) const { return m_present.test(neighbor_id); }
+
+  // Time of the last beacon from `neighbor_id` (meaningful only while it is in the table).
+  double lastHeard(uint8_t neighbor_id) const { return m_last_heard_s[m_slot_of[neighbor_id]]; }
+
+  void onPacketReceived(const ::PacketView& pkt) override;
+
+  // Allocation-free: spans over the packed table. Positions are extrapolated to the
+  // time of the last advance().
+  NeighborSpan neighbors() const override;
+
   void sendToNeighbors(uint8_t id, PositionInterface* position, uint8_t hops_to_base_station) override;
 
  private:
   CommunicationManagerInterface* m_communication_manager;
-  std::unordered_map<uint8_t, std::unique_ptr<NeighborInfo>> m_neighbors;
+  BeaconListener m_beacon_listener;
+  Clock m_clock;
+  NeighborBeaconEncoder m_beacon_encoder;
+  NeighborBeaconDecoder m_beacon_decoder;
+
+  // Neighbor table: ids are uint8_t, so it is a fixed 256-entry struct of arrays.
+  // Live entries are packed in [0, m_count) (removal moves the last entry into the hole)
+  // and m_slot_of maps an id in m_present to its packed index; beacons update in place.
+  // m_x/m_y/m_z hold the extrapolated positions, m_bx/m_by/m_bz the beaconed ones.
+  void upsert(const DecodedBeacon& beacon, double now_s);
+  void remove(uint8_t neighbor_id);
+  void extrapolate(double now_s);
+
+  size_t m_count = 0;
+  std::bitset<256> m_present;
+  std::array<uint8_t, 256> m_slot_of{};
+  std::array<uint8_t, 256> m_ids{};
+  std::array<double, 256> m_x{};
+  std::array<double, 256> m_y{};
+  std::array<double, 256> m_z{};
+  std::array<double, 256> m_bx{};
+  std::array<double, 256> m_by{};
+  std::array<double, 256> m_bz{};
+  std::array<double, 256> m_vx{};
+  std::array<double, 256> m_vy{};
+  std::array<double, 256> m_vz{};
+  std::array<uint8_t, 256> m_hops{};
+  std::array<double, 256> m_last_heard_s{};
+
+  NeighborAgingConfig m_aging;
+  NeighborAgingStats m_aging_stats;
+  NeighborTimingWheel m_wheel;
+  double m_now_s = 0.0;
+
+  double now() const { return m_clock ? m_clock() : m_now_s; }
+
+  // Sender side: what neighbors currently extrapolate for us.
+  NeighborPredictionConfig m_prediction;
+  NeighborBeaconStats m_beacon_stats;
+  bool m_has_sent = false;
+  double m_sent_s = 0.0;
+  uint8_t m_sent_hops = 0;
+  Vector3D m_sent_coords;
+  Vector3D m_sent_velocity{0.0, 0.0, 0.0};  // as encoded; zero if the beacon had none
+  bool m_sent_compact = false;
+
+  AdaptiveRate m_beacon_rate;
+  bool m_mission_active = false;
+  bool m_has_prev_velocity = false;
+  double m_prev_velocity_s = 0.0;
+  Vector3D m_prev_velocity{0.0, 0.0, 0.0};
 };
\ No newline at end of file
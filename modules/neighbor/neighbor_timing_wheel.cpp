@@ -0,0 +1,86 @@
+#include "modules/neighbor/neighbor_timing_wheel.h"
+
+NeighborTimingWheel::NeighborTimingWheel() {
+    m_heads.fill(kNil);
+}
+
+void NeighborTimingWheel::schedule(uint8_t id, uint64_t expiry_tick) {
+    unlink(id);
+    if (expiry_tick <= m_current_tick) {
+        expiry_tick = m_current_tick + 1;
+    }
+    m_entries[id].expiry_tick = expiry_tick;
+    link(id, slotFor(expiry_tick));
+}
+
+void NeighborTimingWheel::cancel(uint8_t id) {
+    unlink(id);
+}
+
+void NeighborTimingWheel::advance(uint64_t now_tick, const ExpireCallback& on_expire) {
+    while (m_current_tick < now_tick) {
+        ++m_current_tick;
+
+        // Every 64 ticks, re-file the level-1 slot that covers the next 64 ticks.
+        if ((m_current_tick & (kSlots - 1)) == 0) {
+            const uint16_t slot = static_cast<uint16_t>(kSlots + ((m_current_tick >> kSlotBits) & (kSlots - 1)));
+            uint16_t id = m_heads[slot];
+            while (id != kNil) {
+                const uint16_t next = m_entries[id].next;
+                unlink(static_cast<uint8_t>(id));
+                link(static_cast<uint8_t>(id), slotFor(m_entries[id].expiry_tick));
+                id = next;
+            }
+        }
+
+        const uint16_t slot = static_cast<uint16_t>(m_current_tick & (kSlots - 1));
+        uint16_t id = m_heads[slot];
+        while (id != kNil) {
+            const uint16_t next = m_entries[id].next;
+            unlink(static_cast<uint8_t>(id));
+            on_expire(static_cast<uint8_t>(id));
+            id = next;
+        }
+    }
+}
+
+void NeighborTimingWheel::link(uint8_t id, uint16_t slot) {
+    Entry& entry = m_entries[id];
+    entry.slot = slot;
+    entry.prev = kNil;
+    entry.next = m_heads[slot];
+    if (entry.next != kNil) {
+        m_entries[entry.next].prev = id;
+    }
+    m_heads[slot] = id;
+}
+
+void NeighborTimingWheel::unlink(uint8_t id) {
+    Entry& entry = m_entries[id];
+    if (entry.slot == kNil) {
+        return;
+    }
+    if (entry.prev != kNil) {
+        m_entries[entry.prev].next = entry.next;
+    } else {
+        m_heads[entry.slot] = entry.next;
+    }
+    if (entry.next != kNil) {
+        m_entries[entry.next].prev = entry.prev;
+    }
+    entry.prev = kNil;
+    entry.next = kNil;
+    entry.slot = kNil;
+}
+
+uint16_t NeighborTimingWheel::slotFor(uint64_t expiry_tick) const {
+    const uint64_t delta = expiry_tick - m_current_tick;
+    if (delta < kSlots) {
+        return static_cast<uint16_t>(expiry_tick & (kSlots - 1));
+    }
+
+    // Beyond level 1's reach: park in the furthest slot; the cascade re-files it.
+    const uint64_t max_delta = kSlots * kSlots - 1;
+    const uint64_t tick = delta <= max_delta ? expiry_tick : m_current_tick + max_delta;
+    return static_cast<uint16_t>(kSlots + ((tick >> kSlotBits) & (kSlots - 1)));
+}
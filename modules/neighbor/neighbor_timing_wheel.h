@@ -0,0 +1,47 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+// Two-level hashed timing wheel keyed by neighbor id (ids are uint8_t).
+// - Level 0: 64 slots of one tick; level 1: 64 slots of 64 ticks (covers 4096 ticks;
+//   later deadlines are parked in the furthest level-1 slot and re-filed on cascade).
+// - Each id is in at most one slot, on an intrusive doubly-linked list, so schedule,
+//   cancel and re-schedule are O(1) and advancing one tick only touches due entries.
+class NeighborTimingWheel {
+ public:
+  using ExpireCallback = std::function<void(uint8_t id)>;
+
+  NeighborTimingWheel();
+
+  uint64_t currentTick() const { return m_current_tick; }
+
+  // (Re)arms `id` to expire at `expiry_tick` (at least one tick from now).
+  void schedule(uint8_t id, uint64_t expiry_tick);
+  void cancel(uint8_t id);
+
+  // Moves time forward to `now_tick`, calling `on_expire` for every id that falls due.
+  void advance(uint64_t now_tick, const ExpireCallback& on_expire);
+
+ private:
+  static constexpr size_t kSlotBits = 6;
+  static constexpr size_t kSlots = size_t{1} << kSlotBits;
+  static constexpr uint16_t kNil = UINT16_MAX;
+
+  struct Entry {
+    uint64_t expiry_tick = 0;
+    uint16_t prev = kNil;
+    uint16_t next = kNil;
+    uint16_t slot = kNil;  // index into m_heads, kNil if not scheduled
+  };
+
+  void link(uint8_t id, uint16_t slot);
+  void unlink(uint8_t id);
+  uint16_t slotFor(uint64_t expiry_tick) const;
+
+  uint64_t m_current_tick = 0;
+  std::array<Entry, 256> m_entries;
+  std::array<uint16_t, 2 * kSlots> m_heads;
+};
@@ -6,7 +6,7 @@ Ns3BaseStation::Ns3BaseStation(
 ) : 
   m_id(id),
   m_node(node),
-  m_comm(std::make_unique<sim::Ns3SocketTransport>(node), id) 
+  m_comm(sim::CreateTransport(node), id) 
 {
   if (!m_node) {
     return;
@@ -14,17 +14,17 @@ Ns3BaseStation::Ns3BaseStation(
 
   m_transport_ip = sim::RadioEnvironment::Get().Install(m_node).ip;
 
-  auto mobility = m_node->GetObject<::ns3::ConstantPositionMobilityModel>();
+  auto mobility = m_node->GetObject<KinematicMobilityModel>();
   if (!mobility) {
-    mobility = ::ns3::CreateObject<::ns3::ConstantPositionMobilityModel>();
+    mobility = ::ns3::CreateObject<KinematicMobilityModel>();
     m_node->AggregateObject(mobility);
   }
 
   m_custom_mobility = std::make_unique<CustomMobility>(mobility);
   m_position = std::make_unique<Ns3Position>(m_custom_mobility.get());
 
-  m_comm.setReceiveHandler([this](const ::Packet& pkt) { dispatchPacket(pkt); });
-  m_dispatcher.setFallbackHandler([this](const ::Packet& pkt) { handleCorePacket(pkt); });
+  m_comm.setReceiveHandler([this](const ::PacketView& pkt) { dispatchPacket(pkt); });
+  m_dispatcher.setFallbackHandler([this](const ::PacketView& pkt) { handleCorePacket(pkt); });
 }
 
 void Ns3BaseStation::start() {
@@ -32,8 +32,18 @@ void Ns3BaseStation::start() {
   ::ns3::Simulator::Schedule(::ns3::Seconds(initial_delay_s), ::ns3::MakeCallback(&Ns3BaseStation::onTick, this));
 }
 
+void Ns3BaseStation::setFloodSchedule(const FloodScheduleConfig& config) {
+  m_flood_schedule = config;
+  m_flood_interval_s = config.min_interval_s;
+}
+
 void Ns3BaseStation::onTick() {
-  if (!m_drone_ips.empty()) {
+  const double now_s = ::ns3::Simulator::Now().GetSeconds();
+  checkSilentDrones(now_s);
+
+  // Half a tick of slack so the tick grid does not push floods one tick late.
+  const bool flood_due = !m_flood_schedule.adaptive || now_s + 0.5 * m_tick_dt_s >= m_next_flood_s;
+  if (flood_due && !m_drone_ips.empty()) {
     // Choose a stable initiator: the lowest registered drone id.
     uint8_t initiator = 0;
     for (const auto& kv : m_drone_ips) {
@@ -41,7 +51,11 @@ void Ns3BaseStation::onTick() {
     }
     if (initiator != 0) {
       requestFlood(++m_flood_seq, initiator);
+      ++m_floods_requested;
     }
+
+    m_next_flood_s = now_s + m_flood_interval_s;
+    m_flood_interval_s = std::min(m_flood_interval_s * m_flood_schedule.backoff_factor, m_flood_schedule.max_interval_s);
   }
 
   ::ns3::Simulator::Schedule(::ns3::Seconds(m_tick_dt_s), ::ns3::MakeCallback(&Ns3BaseStation::onTick, this));
@@ -77,7 +91,7 @@ void Ns3BaseStation::requestFlood(uint16_t flood_id, uint8_t initiator_drone_id)
   m_comm.send(out);
 }
 
-void Ns3BaseStation::dispatchPacket(const ::Packet& pkt) {
+void Ns3BaseStation::dispatchPacket(const ::PacketView& pkt) {
   if (pkt.payload.empty()) {
     return;
   }
@@ -89,7 +103,7 @@ void Ns3BaseStation::dispatchPacket(const ::Packet& pkt) {
   m_dispatcher.handlePacket(pkt);
 }
 
-void Ns3BaseStation::handleCorePacket(const ::Packet& pkt) {
+void Ns3BaseStation::handleCorePacket(const ::PacketView& pkt) {
   if (pkt.payload.size() < 1) {
     return;
   }
@@ -106,7 +120,18 @@ void Ns3BaseStation::handleCorePacket(const ::Packet& pkt) {
       return;
     }
 
-    case SimMsgType::HELP_PROXY:
+    case SimMsgType::HELP_PROXY: {
+      if (pkt.payload.size() < sizeof(HelpProxyMsg)) {
+        return;
+      }
+      HelpProxyMsg msg;
+      std::memcpy(&msg, pkt.payload.data(), sizeof(msg));
+      if (msg.base_id == m_id) {
+        noteTopologyChange();
+      }
+      return;
+    }
+
     case SimMsgType::POS_ACK:
     default:
       return;
@@ -121,23 +146,87 @@ void Ns3BaseStation::handlePositionUpdate(const PositionUpdateMsg& msg, uint8_t
   // Track last seen position.
   m_last_position[msg.drone_id] = msg;
 
+  // A first report, a drone back from silence or a confirmed path change all change the topology.
+  auto [it, inserted] = m_links.try_emplace(msg.drone_id);
+  DroneLink& link = it->second;
+  bool changed = inserted || link.silent;
+
+  if (!link.has_round || msg.seq != link.round_seq) {
+    // Copies of an older update arriving late say nothing about the current paths.
+    if (link.has_round && static_cast<int16_t>(msg.seq - link.round_seq) < 0) {
+      link.last_rx_s = ::ns3::Simulator::Now().GetSeconds();
+      sendPositionAck(msg.drone_id, msg.seq, relay_src);
+      return;
+    }
+    if (link.has_round) {
+      changed = closePathRound(link) || changed;
+    }
+    link.has_round = true;
+    link.round_seq = msg.seq;
+    link.round_paths.reset();
+  }
+  link.round_paths.set(relay_src);
+
+  if (changed) {
+    noteTopologyChange();
+  }
+  link.last_rx_s = ::ns3::Simulator::Now().GetSeconds();
+  link.silent = false;
+
   sendPositionAck(msg.drone_id, msg.seq, relay_src);
 }
 
+bool Ns3BaseStation::closePathRound(DroneLink& link) const {
+  if (!link.paths_known) {
+    link.paths = link.round_paths;
+    link.paths_known = true;
+    return false;
+  }
+
+  bool changed = false;
+  const std::bitset<256> differing = link.paths ^ link.round_paths;
+  for (size_t path = 0; path < link.path_streak.size(); ++path) {
+    if (!differing.test(path)) {
+      link.path_streak[path] = 0;
+      continue;
+    }
+    if (++link.path_streak[path] >= std::max<uint8_t>(1, m_flood_schedule.path_confirm_updates)) {
+      link.paths.flip(path);
+      link.path_streak[path] = 0;
+      changed = true;
+    }
+  }
+  return changed;
+}
+
+void Ns3BaseStation::noteTopologyChange() {
+  m_flood_interval_s = m_flood_schedule.min_interval_s;
+  m_next_flood_s = ::ns3::Simulator::Now().GetSeconds();
+}
+
+void Ns3BaseStation::checkSilentDrones(double now_s) {
+  for (auto& [drone_id, link] : m_links) {
+    if (!link.silent && (now_s - link.last_rx_s) > m_flood_schedule.silence_timeout_s) {
+      link.silent = true;
+      noteTopologyChange();
+    }
+  }
+}
+
 void Ns3BaseStation::sendPositionAck(uint8_t drone_id, uint16_t seq, uint8_t relay_src) {
   if (m_position) {
     m_position->retrieveCurrentPosition();
   }
-  const auto coords = m_position ? m_position->getCoordinates() : std::vector<double>{};
+  const Vector3D coords = m_position ? m_position->getCoordinates() : Vector3D{};
 
   PositionAckMsg ack;
   ack.base_id = m_id;
   ack.drone_id = drone_id;
   ack.seq = seq;
   ack.base_hops_to_base_station = 0;
-  ack.x = coords.size() > 0 ? coords[0] : 0.0;
-  ack.y = coords.size() > 1 ? coords[1] : 0.0;
-  ack.z = coords.size() > 2 ? coords[2] : 0.0;
+  ack.x = coords.x;
+  ack.y = coords.y;
+  ack.z = coords.z;
 
   ::Packet out;
   out.type = ::PacketType::CORE;
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <bitset>
 #include <cstdint>
 #include <unordered_map>
 #include <cstring>
@@ -14,14 +17,33 @@
 #include "common/packet.h"
 
 #include "ns3/core-module.h"
-#include "ns3/constant-position-mobility-model.h"
+#include "ns3/mobility-model.h"
 #include "ns3/internet-module.h"
 
 #include "platform/ns3/custom_mobility/custom_mobility.h"
 #include "platform/ns3/position/ns3_position.h"
-#include "platform/ns3/transport/ns3_socket_transport.h"
+#include "platform/ns3/transport/transport_factory.h"
 #include "platform/ns3/radio_environment/radio_environment.h"
 
+// Flood pacing at the base station. With `adaptive` set the flood interval doubles (by
+// `backoff_factor`) after every flood while the topology looks stable, up to `max_interval_s`,
+// and snaps back to `min_interval_s` on a topology change: a drone going silent for
+// `silence_timeout_s`, a drone (re)appearing, a change in its set of reporting paths, or a
+// HELP_PROXY. A drone's paths are the direct link and every relay forwarding its updates;
+// a path only counts as gained or lost once it has been so for `path_confirm_updates`
+// consecutive updates, so the copies of one broadcast POS_UPDATE do not look like churn.
+// The silence timeout should span several POS_UPDATE keep-alives (a still drone sends one
+// every ACK timeout / 3 with adaptive rates), so one late update is not a topology change;
+// the default is the drone's own ACK timeout.
+struct FloodScheduleConfig {
+  bool adaptive = false;
+  double min_interval_s = 0.05;
+  double max_interval_s = 1.6;
+  double backoff_factor = 2.0;
+  double silence_timeout_s = 1.5;
+  uint8_t path_confirm_updates = 3;
+};
+
 // NS-3 bound base station node logic.
 // - Static position.
 // - Never broadcasts. All sends are unicast.
@@ -45,14 +67,21 @@ class Ns3BaseStation {
   // Optional: base can trigger a new flood by unicast start to an initiator drone.
   void requestFlood(uint16_t flood_id, uint8_t initiator_drone_id);
 
+  void setFloodSchedule(const FloodScheduleConfig& config);
+  uint64_t floodsRequested() const { return m_floods_requested; }
+
  private:
   void onTick();
 
-  void dispatchPacket(const ::Packet& pkt);
-  void handleCorePacket(const ::Packet& pkt);
+  void dispatchPacket(const ::PacketView& pkt);
+  void handleCorePacket(const ::PacketView& pkt);
 
   void handlePositionUpdate(const PositionUpdateMsg& msg, uint8_t relay_src);
 
+  // Resets the flood interval so the next tick floods.
+  void noteTopologyChange();
+  void checkSilentDrones(double now_s);
+
   void sendPositionAck(uint8_t drone_id, uint16_t seq, uint8_t relay_src);
 
   uint8_t m_id;
@@ -69,6 +98,30 @@ class Ns3BaseStation {
   std::unordered_map<uint8_t, ::ns3::Ipv4Address> m_drone_ips;
   std::unordered_map<uint8_t, PositionUpdateMsg> m_last_position;
 
+  // Per-drone reporting paths, used to detect topology changes. Paths are keyed by the
+  // id the update arrived from (the drone itself when direct). Copies of one update
+  // (same seq) form a round; a round is compared with the confirmed set when the next
+  // update starts.
+  struct DroneLink {
+    double last_rx_s = 0.0;
+    bool silent = false;
+    bool has_round = false;
+    bool paths_known = false;
+    uint16_t round_seq = 0;
+    std::bitset<256> round_paths;
+    std::bitset<256> paths;
+    std::array<uint8_t, 256> path_streak{};  // consecutive rounds disagreeing with `paths`
+  };
+
+  // Folds the finished round into the confirmed paths; true if a path was gained or lost.
+  bool closePathRound(DroneLink& link) const;
+  std::unordered_map<uint8_t, DroneLink> m_links;
+
+  FloodScheduleConfig m_flood_schedule;
+  double m_flood_interval_s = 0.05;
+  double m_next_flood_s = 0.0;
+
   double m_tick_dt_s = 0.05;
-  uint16_t m_flood_seq = 0;
+  uint16_t m_flood_seq = 0;  // wire id, wraps
+  uint64_t m_floods_requested = 0;
 };
@@ -1,24 +1,34 @@
 #pragma once
-#include <vector>
+
+#include <functional>
 
 #include "ns3/core-module.h"
-#include "ns3/constant-position-mobility-model.h"
 #include "common/vector3D.h"
+#include "platform/ns3/custom_mobility/kinematic_mobility_model.h"
+#include "platform/ns3/radio_environment/radio_environment.h"
 
+// Node-side handle on a KinematicMobilityModel: commands go in as acceleration + speed
+// cap, positions and velocities come out evaluated at Now().
 class CustomMobility {
     public:
-        CustomMobility(ns3::Ptr<ns3::ConstantPositionMobilityModel> mobility);
+        CustomMobility(ns3::Ptr<KinematicMobilityModel> mobility);
         void setPosition(const double x, const double y, const double z); 
-        void update();
-        std::vector<double> getPosition();
+        Vector3D getPosition() const;
+        Vector3D getVelocity() const;
+        Vector3D getAcceleration() const;
         void updateVelocity(const Vector3D acceleration, const double max_velocity);
+
+        // Time (s) at which the current motion leaves the sphere; see KinematicMobilityModel::PredictExit.
+        double predictExit(const Vector3D& center, double radius) const;
+
+        // Called after every change of motion segment (new command or explicit position).
+        void setCourseChangeListener(std::function<void()> listener);
         
     private:
-        ns3::Ptr<ns3::MobilityModel> mobility;
-        ns3::Vector previous_position;
-        double previous_time_s = 0.0;  // NS-3 simulation time (seconds)
-        double delta_t_max_velocity_s = 0.0;
-        double max_velocity = 0.0;
-        Vector3D acceleration;
-        Vector3D velocity;
-    };
\ No newline at end of file
+        // Keeps the radio spatial grid in sync; called once per command (every tick).
+        void publishPosition();
+
+        ns3::Ptr<KinematicMobilityModel> mobility;
+        ns3::Ptr<ns3::Node> node;
+        std::function<void()> course_change_listener;
+    };
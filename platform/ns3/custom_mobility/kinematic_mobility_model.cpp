@@ -0,0 +1,267 @@
+#include "platform/ns3/custom_mobility/kinematic_mobility_model.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+NS_OBJECT_ENSURE_REGISTERED(KinematicMobilityModel);
+
+namespace {
+
+constexpr double kInf = std::numeric_limits<double>::infinity();
+
+double dot(const Vector3D& a, const Vector3D& b) {
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+// First t >= 0 with |r + v t| >= radius, for |r| < radius.
+double exitLinear(const Vector3D& r, const Vector3D& v, double radius) {
+    const double A = v.squared_module();
+    if (A == 0.0) {
+        return kInf;
+    }
+    const double B = 2.0 * dot(r, v);
+    const double C = r.squared_module() - radius * radius;
+    // C < 0: the roots have opposite signs and the exit is the positive one.
+    return (-B + std::sqrt(B * B - 4.0 * A * C)) / (2.0 * A);
+}
+
+// f(t) = |r + v t + a t^2 / 2|^2 - radius^2 as a quartic c[0] + c[1] t + ... + c[4] t^4.
+struct ExitQuartic {
+    double c[5];
+
+    ExitQuartic(const Vector3D& r, const Vector3D& v, const Vector3D& a, double radius) {
+        c[0] = r.squared_module() - radius * radius;
+        c[1] = 2.0 * dot(r, v);
+        c[2] = v.squared_module() + dot(r, a);
+        c[3] = dot(v, a);
+        c[4] = a.squared_module() / 4.0;
+    }
+
+    double operator()(double t) const {
+        return (((c[4] * t + c[3]) * t + c[2]) * t + c[1]) * t + c[0];
+    }
+
+    // Real roots of f'(t) = c[1] + 2 c[2] t + 3 c[3] t^2 + 4 c[4] t^3 (c[4] > 0), ascending.
+    size_t criticalPoints(double out[3]) const {
+        const double a = 3.0 * c[3] / (4.0 * c[4]);
+        const double b = 2.0 * c[2] / (4.0 * c[4]);
+        const double d = c[1] / (4.0 * c[4]);
+        // Depressed cubic t = s - a/3: s^3 + p s + q = 0.
+        const double p = b - a * a / 3.0;
+        const double q = 2.0 * a * a * a / 27.0 - a * b / 3.0 + d;
+        const double shift = -a / 3.0;
+        const double disc = q * q / 4.0 + p * p * p / 27.0;
+        if (disc > 0.0) {
+            const double sq = std::sqrt(disc);
+            out[0] = std::cbrt(-q / 2.0 + sq) + std::cbrt(-q / 2.0 - sq) + shift;
+            return 1;
+        }
+        if (p == 0.0) {
+            out[0] = shift;
+            return 1;
+        }
+        // Three real roots (trigonometric form).
+        const double m = 2.0 * std::sqrt(-p / 3.0);
+        const double theta = std::acos(std::clamp(3.0 * q / (p * m), -1.0, 1.0)) / 3.0;
+        for (size_t k = 0; k < 3; ++k) {
+            out[k] = m * std::cos(theta - 2.0 * std::numbers::pi * static_cast<double>(2 - k) / 3.0) + shift;
+        }
+        std::sort(out, out + 3);
+        return 3;
+    }
+};
+
+// First t in [lo, hi] with f(t) >= 0 for f(lo) < 0; f is split into monotonic pieces at its
+// critical points and the first piece that ends outside is bisected.
+double exitQuartic(const ExitQuartic& f, double lo, double hi) {
+    double crit[3];
+    const size_t n = f.criticalPoints(crit);
+    double breaks[4];
+    size_t nb = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (crit[i] > lo && crit[i] < hi) {
+            breaks[nb++] = crit[i];
+        }
+    }
+    if (std::isinf(hi)) {
+        // Past its last critical point f grows without bound: find a finite end.
+        double end = std::max(lo, nb > 0 ? breaks[nb - 1] : lo) + 1.0;
+        while (f(end) < 0.0 && end < 1e9) {
+            end *= 2.0;
+        }
+        breaks[nb++] = end;
+    } else {
+        breaks[nb++] = hi;
+    }
+
+    double a = lo;
+    for (size_t i = 0; i < nb; ++i) {
+        double b = breaks[i];
+        if (f(b) >= 0.0) {
+            for (int iter = 0; iter < 100 && (b - a) > 1e-12 * std::max(1.0, b); ++iter) {
+                const double mid = 0.5 * (a + b);
+                (f(mid) >= 0.0 ? b : a) = mid;
+            }
+            return b;
+        }
+        a = b;
+    }
+    return kInf;
+}
+
+}  // namespace
+
+ns3::TypeId KinematicMobilityModel::GetTypeId() {
+    static ns3::TypeId tid = ns3::TypeId("KinematicMobilityModel")
+        .SetParent<ns3::MobilityModel>()
+        .SetGroupName("Mobility")
+        .AddConstructor<KinematicMobilityModel>();
+    return tid;
+}
+
+KinematicMobilityModel::KinematicMobilityModel() = default;
+
+bool KinematicMobilityModel::SetCommand(const Vector3D& acceleration, double max_speed) {
+    const double now_s = ns3::Simulator::Now().GetSeconds();
+    const State state = Evaluate(now_s);
+
+    const bool same_command = acceleration.x == m_acceleration.x &&
+                              acceleration.y == m_acceleration.y &&
+                              acceleration.z == m_acceleration.z &&
+                              max_speed == m_max_speed;
+    if (same_command && !Turning(now_s, state)) {
+        return false;
+    }
+
+    m_acceleration = acceleration;
+    m_max_speed = max_speed;
+    StartSegment(now_s, state);
+    NotifyCourseChange();
+    return true;
+}
+
+bool KinematicMobilityModel::Turning(double now_s, const State& state) const {
+    if (m_clamped) {
+        return (state.velocity - m_velocity).module() > kEpsilon;
+    }
+    if (now_s - m_start_s <= m_saturation_s) {
+        return false;
+    }
+    // Coasting at the cap: only an acceleration along the velocity leaves it unchanged.
+    const Vector3D& v = state.velocity;
+    const Vector3D& a = m_acceleration;
+    const Vector3D cross(v.y * a.z - v.z * a.y, v.z * a.x - v.x * a.z, v.x * a.y - v.y * a.x);
+    return cross.module() > kEpsilon * v.module() * a.module();
+}
+
+ns3::Vector KinematicMobilityModel::DoGetPosition() const {
+    const Vector3D p = Evaluate(ns3::Simulator::Now().GetSeconds()).position;
+    return ns3::Vector(p.x, p.y, p.z);
+}
+
+void KinematicMobilityModel::DoSetPosition(const ns3::Vector& position) {
+    const double now_s = ns3::Simulator::Now().GetSeconds();
+    State state = Evaluate(now_s);
+    state.position = Vector3D(position.x, position.y, position.z);
+    StartSegment(now_s, state);
+    NotifyCourseChange();
+}
+
+ns3::Vector KinematicMobilityModel::DoGetVelocity() const {
+    const Vector3D v = Evaluate(ns3::Simulator::Now().GetSeconds()).velocity;
+    return ns3::Vector(v.x, v.y, v.z);
+}
+
+double KinematicMobilityModel::PredictExit(const Vector3D& center, double radius) const {
+    const double now_s = ns3::Simulator::Now().GetSeconds();
+    const State state = Evaluate(now_s);
+    const Vector3D r = state.position - center;
+    if (r.squared_module() >= radius * radius) {
+        return now_s;
+    }
+
+    const double t = std::max(0.0, now_s - m_start_s);
+    if (m_clamped || m_acceleration.module() == 0.0) {
+        return now_s + exitLinear(r, state.velocity, radius);
+    }
+
+    // Accelerating: r(t) = r0 + v0 t + a t^2 / 2 up to the cap, then a straight coast.
+    if (t < m_saturation_s) {
+        const ExitQuartic f(m_position - center, m_velocity, m_acceleration, radius);
+        const double exit = exitQuartic(f, t, m_saturation_s);
+        if (!std::isinf(exit) || std::isinf(m_saturation_s)) {
+            return m_start_s + exit;
+        }
+        const State at_cap = Evaluate(m_start_s + m_saturation_s);
+        return m_start_s + m_saturation_s + exitLinear(at_cap.position - center, at_cap.velocity, radius);
+    }
+    return now_s + exitLinear(r, state.velocity, radius);
+}
+
+Vector3D KinematicMobilityModel::Clamp(const Vector3D& velocity) const {
+    if (m_max_speed > 0.0 && velocity.module() > m_max_speed) {
+        return velocity.unit_vector() * m_max_speed;
+    }
+    return velocity;
+}
+
+KinematicMobilityModel::State KinematicMobilityModel::Evaluate(double now_s) const {
+    const double t = now_s - m_start_s;
+    if (t <= 0.0) {
+        return State{m_position, m_velocity};
+    }
+
+    if (t <= m_saturation_s) {
+        // Trapezoid of the end velocities: exact while unclamped (p0 + v0 t + a t^2 / 2).
+        const Vector3D v = Clamp(m_velocity + m_acceleration * t);
+        return State{m_position + (m_velocity + v) * (t / 2.0), v};
+    }
+
+    // Accelerate up to the cap, then coast.
+    const double t_accel = m_saturation_s;
+    const Vector3D v_at_max = Clamp(m_velocity + m_acceleration * t_accel);
+    return State{
+        m_position + (m_velocity + v_at_max) * (t_accel / 2.0) + v_at_max * (t - t_accel),
+        v_at_max
+    };
+}
+
+void KinematicMobilityModel::StartSegment(double now_s, const State& state) {
+    m_start_s = now_s;
+    m_position = state.position;
+    m_velocity = state.velocity;
+    m_saturation_s = std::numeric_limits<double>::infinity();
+    m_clamped = false;
+
+    if (m_max_speed <= 0.0) {
+        return;
+    }
+    const double speed = m_velocity.module();
+    if (m_acceleration.module() == 0.0) {
+        // Above a lowered cap: slowed down by the clamp, then constant.
+        m_clamped = speed > m_max_speed;
+        return;
+    }
+
+    // Time to (re)reach the cap: the t > 0 with |v0 + a t|^2 = v_max^2, i.e.
+    // A t^2 + B t + C = 0 with A = |a|^2, B = 2 (v0 . a), C = |v0|^2 - v_max^2.
+    const double A = m_acceleration.squared_module();
+    if (speed >= m_max_speed * (1.0 - kEpsilon)) {
+        m_velocity = m_velocity.unit_vector() * m_max_speed;
+        const double B = 2.0 * (m_velocity.x * m_acceleration.x + m_velocity.y * m_acceleration.y + m_velocity.z * m_acceleration.z);
+        if (B < 0.0) {
+            // Pointing back inside the cap: free motion until the speed is back at the cap.
+            m_saturation_s = -B / A;
+        } else {
+            // The acceleration only steers the velocity along the cap.
+            m_clamped = true;
+        }
+        return;
+    }
+
+    // Below the cap C < 0, so there is exactly one positive root.
+    const double B = 2.0 * (m_velocity.x * m_acceleration.x + m_velocity.y * m_acceleration.y + m_velocity.z * m_acceleration.z);
+    const double C = m_velocity.squared_module() - m_max_speed * m_max_speed;
+    m_saturation_s = (-B + std::sqrt(B * B - 4.0 * A * C)) / (2.0 * A);
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <limits>
+
+#include "ns3/core-module.h"
+#include "ns3/mobility-model.h"
+#include "common/vector3D.h"
+
+// Piecewise kinematic mobility model. Each segment starts at the last command change
+// with a position, velocity, commanded acceleration and speed cap, plus the time at
+// which the cap is reached; positions and velocities are evaluated analytically from
+// it on demand, so nothing has to be written back every tick.
+//
+// Within a segment (t = time since its start, t_s = time to reach the cap):
+//   t <= t_s: v(t) = clamp(v0 + a t), p(t) = p0 + (v0 + v(t)) / 2 * t
+//   t >  t_s: accelerate for t_s, then coast at v(t_s).
+// Before the cap this is exact constant-acceleration motion; once at the cap it is the
+// same clamped step the per-tick integrator used, taken over the whole segment.
+class KinematicMobilityModel : public ns3::MobilityModel {
+    public:
+        static ns3::TypeId GetTypeId();
+
+        KinematicMobilityModel();
+
+        // Starts a new segment at Now() if the command differs from the current one, or if
+        // the acceleration is turning the velocity at the cap (the segment formula only
+        // covers one integrator step of that). Returns true if it did; only then is a
+        // course change notified.
+        bool SetCommand(const Vector3D& acceleration, double max_speed);
+
+        Vector3D GetAcceleration() const { return m_acceleration; }
+
+        // Absolute time (s) at which the current segment first leaves the sphere of `radius`
+        // around `center`: Now() if already outside, +inf if it stays inside. Clamped
+        // segments are extrapolated at their current velocity (they are rebased every
+        // command anyway).
+        double PredictExit(const Vector3D& center, double radius) const;
+
+    private:
+        struct State {
+            Vector3D position;
+            Vector3D velocity;
+        };
+
+        ns3::Vector DoGetPosition() const override;
+        void DoSetPosition(const ns3::Vector& position) override;
+        ns3::Vector DoGetVelocity() const override;
+
+        static constexpr double kEpsilon = 1e-9;
+
+        State Evaluate(double now_s) const;
+        bool Turning(double now_s, const State& state) const;
+        Vector3D Clamp(const Vector3D& velocity) const;
+        // Rebases the segment on `state` at `now_s` and solves the time to reach the cap.
+        // A segment starting at the cap with the acceleration pointing outwards is clamped.
+        void StartSegment(double now_s, const State& state);
+
+        double m_start_s = 0.0;
+        Vector3D m_position{0.0, 0.0, 0.0};
+        Vector3D m_velocity{0.0, 0.0, 0.0};
+        Vector3D m_acceleration{0.0, 0.0, 0.0};
+        double m_max_speed = 0.0;
+        double m_saturation_s = std::numeric_limits<double>::infinity();
+        bool m_clamped = false;  // v(t) is clamped from t = 0
+};
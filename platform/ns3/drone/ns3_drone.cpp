@@ -11,7 +11,7 @@ Ns3Drone::Ns3Drone(
 ) : 
   m_id(id),
   m_node(node),
-  m_comm(std::make_unique<sim::Ns3SocketTransport>(node), id),
+  m_comm(sim::CreateTransport(node), id),
   m_controller(id, k_att, k_rep, d_safe, v_max, drone_weight_kg)
 {
   if (!m_node) {
@@ -20,24 +20,39 @@ Ns3Drone::Ns3Drone(
 
   m_transport_ip = sim::RadioEnvironment::Get().Install(m_node).ip;
 
-  auto mobility = m_node->GetObject<::ns3::ConstantPositionMobilityModel>();
+  auto mobility = m_node->GetObject<KinematicMobilityModel>();
   if (!mobility) {
-    mobility = ::ns3::CreateObject<::ns3::ConstantPositionMobilityModel>();
+    mobility = ::ns3::CreateObject<KinematicMobilityModel>();
     m_node->AggregateObject(mobility);
   }
 
   m_custom_mobility = std::make_unique<CustomMobility>(mobility);
   m_position = std::make_unique<Ns3Position>(m_custom_mobility.get());
   m_velocity_actuator = std::make_unique<Ns3VelocityActuator>(m_custom_mobility.get());
-
-  m_comm.setReceiveHandler([this](const ::Packet& pkt) { dispatchPacket(pkt); });
-
-  m_flood_manager = std::make_unique<FloodManager>(m_id, m_comm, [this]() { return isBaseReachable(); });
+  m_custom_mobility->setCourseChangeListener([this]() { armCoverageExit(); });
+
+  m_comm.setReceiveHandler([this](const ::PacketView& pkt) { dispatchPacket(pkt); });
+  m_comm.setCoalescing(true);
+
+  m_flood_manager = std::make_unique<FloodManager>(m_id, m_comm);
+  m_flood_manager->setScheduler([this](double delay_s, std::function<void()> task) {
+    ::ns3::Simulator::Schedule(::ns3::Seconds(delay_s), [this, task = std::move(task)]() {
+      task();
+      // Relays sent outside a tick or a receive would otherwise wait for the next flush.
+      m_comm.flush();
+    });
+  });
   m_neighbor_manager = std::make_unique<NeighborManager>(&m_comm);
+  m_distance_vector = std::make_unique<DistanceVectorManager>(m_id, m_neighbor_manager.get());
+  setNeighborAging(NeighborAgingConfig{});
+  m_neighbor_manager->setClock([]() { return ::ns3::Simulator::Now().GetSeconds(); });
+  m_neighbor_manager->setBeaconListener([this](uint8_t neighbor_id, uint8_t) {
+    m_distance_vector->onNeighborBeacon(neighbor_id, ::ns3::Simulator::Now().GetSeconds());
+  });
 
   m_dispatcher.setFloodManager(m_flood_manager.get());
   m_dispatcher.setNeighborManager(m_neighbor_manager.get());
-  m_dispatcher.setFallbackHandler([this](const ::Packet& pkt) { handleCorePacket(pkt); });
+  m_dispatcher.setFallbackHandler([this](const ::PacketView& pkt) { handleCorePacket(pkt); });
 
   m_last_ack_rx_s = ::ns3::Simulator::Now().GetSeconds();
 
@@ -58,14 +73,95 @@ void Ns3Drone::setBaseStation(uint8_t base_id, ::ns3::Ipv4Address base_ip, Posit
   if (m_flood_manager) {
     m_flood_manager->setBaseId(base_id);
   }
+  if (m_distance_vector) {
+    m_distance_vector->setBaseId(base_id);
+  }
+  markBaseReachable();
+  armCoverageExit();
 }
 
 void Ns3Drone::start() {
   ::ns3::Simulator::Schedule(::ns3::Seconds(m_tick_phase_s), ::ns3::MakeCallback(&Ns3Drone::onTick, this));
 }
 
-void Ns3Drone::setRepositionLogger(const std::shared_ptr<std::ofstream>& csv) {
-  m_reposition_csv = csv;
+void Ns3Drone::setMessageCoalescing(bool enabled) {
+  m_comm.setCoalescing(enabled);
+}
+
+void Ns3Drone::setFloodSuppression(const FloodSuppressionConfig& config) {
+  if (m_flood_manager) {
+    m_flood_manager->setSuppression(config);
+  }
+}
+
+void Ns3Drone::setFloodReportAggregation(double window_s) {
+  if (m_flood_manager) {
+    m_flood_manager->setReportAggregation(window_s);
+  }
+}
+
+void Ns3Drone::setNeighborAging(const NeighborAgingConfig& config) {
+  if (m_neighbor_manager) {
+    // Aging advances with the drone tick.
+    NeighborAgingConfig aging = config;
+    aging.tick_s = m_tick_dt_s;
+    m_neighbor_manager->setAging(aging);
+  }
+}
+
+void Ns3Drone::setBeaconFormat(const NeighborBeaconConfig& config) {
+  if (m_neighbor_manager) {
+    m_neighbor_manager->setBeaconFormat(config);
+  }
+}
+
+void Ns3Drone::setAdaptiveRates(const AdaptiveRateConfig& config) {
+  // Several updates per ACK timeout, so one lost update or ACK does not trigger HELP_PROXY.
+  AdaptiveRateConfig pos_config = config;
+  pos_config.max_interval_s = std::min(config.max_interval_s, m_ack_timeout_s / 3.0);
+  m_pos_rate.setConfig(pos_config);
+  if (m_neighbor_manager) {
+    m_neighbor_manager->setBeaconRate(config);
+  }
+}
+
+void Ns3Drone::setBeaconPrediction(const NeighborPredictionConfig& config) {
+  if (m_neighbor_manager) {
+    m_neighbor_manager->setPrediction(config);
+  }
+}
+
+NeighborBeaconStats Ns3Drone::beaconStats() const {
+  return m_neighbor_manager ? m_neighbor_manager->beaconStats() : NeighborBeaconStats{};
+}
+
+NeighborAgingStats Ns3Drone::neighborAgingStats() const {
+  return m_neighbor_manager ? m_neighbor_manager->agingStats() : NeighborAgingStats{};
+}
+
+void Ns3Drone::setHopEngine(HopEngine engine) {
+  m_hop_engine = engine;
+}
+
+void Ns3Drone::setCoveragePrediction(const CoveragePredictionConfig& config) {
+  m_coverage_prediction = config;
+  armCoverageExit();
+}
+
+FloodManagerInterface* Ns3Drone::hopEngine() const {
+  if (m_hop_engine == HopEngine::DISTANCE_VECTOR) {
+    return m_distance_vector.get();
+  }
+  return m_flood_manager.get();
+}
+
+FloodSuppressionStats Ns3Drone::floodSuppressionStats() const {
+  return m_flood_manager ? m_flood_manager->suppressionStats() : FloodSuppressionStats{};
+}
+
+void Ns3Drone::setTrajectoryTrace(const std::shared_ptr<TrajectoryTrace>& trace, double sample_dt_s) {
+  m_trajectory_trace = trace;
+  m_trace_dt_s = std::max(0.0, sample_dt_s);
 }
 
 void Ns3Drone::startMission() {
@@ -74,59 +170,55 @@ void Ns3Drone::startMission() {
   }
 
   m_controller.setMissionActive(true);
+  m_neighbor_manager->setMissionActive(true);
 
   m_mission_start_s = ::ns3::Simulator::Now().GetSeconds();
   m_last_mission_log_s = -1.0;
+  m_last_trace_s = -1.0;
 
-  std::cout << "[Mission] t=" << m_mission_start_s << "s drone=" << static_cast<int>(m_id)
-            << " mission_active=1" << std::endl;
+  SWARM_LOG(INFO, MISSION_START, m_mission_start_s, m_id);
 }
 
 void Ns3Drone::stopMission() {
   m_controller.setMissionActive(false);
+  if (m_neighbor_manager) {
+    m_neighbor_manager->setMissionActive(false);
+  }
 }
 
 void Ns3Drone::onTick() {
+  tick();
+  ::ns3::Simulator::Schedule(::ns3::Seconds(m_tick_dt_s), ::ns3::MakeCallback(&Ns3Drone::onTick, this));
+}
+
+void Ns3Drone::tick() {
   const double now_s = ::ns3::Simulator::Now().GetSeconds();
   if (m_waiting_ack && (now_s - m_last_ack_rx_s) > m_ack_timeout_s && !help_proxy_sent) {
-    sendHelpProxy();
+    sendHelpProxy("ACK_TIMEOUT");
     m_waiting_ack = false;
   }
 
   // Post-mission debug: log how drones reposition 
   if (m_mission_start_s >= 0.0) {
-    if (m_last_mission_log_s < 0.0 || (now_s - m_last_mission_log_s) >= m_mission_log_dt_s) {
-      if (m_position) {
-        m_position->retrieveCurrentPosition();
-        const auto coords = m_position->getCoordinates();
-        const uint8_t hops = m_flood_manager ? m_flood_manager->getHopsFromBase() : UINT8_MAX;
-        const size_t n_neighbors = m_neighbor_manager ? m_neighbor_manager->getNeighbors().size() : 0;
-        std::cout << "[Reposition] t=" << now_s << "delta_t" << (now_s - m_last_mission_log_s) << "s drone=" << static_cast<int>(m_id)
-                  << " hops=" << static_cast<int>(hops)
-                  << " neighbors=" << n_neighbors
-                  << " pos=(" << (coords.size() > 0 ? coords[0] : 0.0)
-                  << "," << (coords.size() > 1 ? coords[1] : 0.0)
-                  << "," << (coords.size() > 2 ? coords[2] : 0.0) << ")";
-
-        if (m_last_help_proxy_rx_s >= 0.0) {
-          std::cout << " after_HELP_PROXY_RX(t=" << m_last_help_proxy_rx_s << "s)";
-        }
-        if (m_last_help_proxy_tx_s >= 0.0) {
-          std::cout << " after_HELP_PROXY_TX(t=" << m_last_help_proxy_tx_s << "s)";
-        }
-        std::cout << std::endl;
-
-        if (m_reposition_csv && m_reposition_csv->good()) {
-          (*m_reposition_csv) << now_s << ","
-                              << static_cast<int>(m_id) << ","
-                              << static_cast<int>(hops) << ","
-                              << n_neighbors << ","
-                              << (coords.size() > 0 ? coords[0] : 0.0) << ","
-                              << (coords.size() > 1 ? coords[1] : 0.0) << ","
-                              << (coords.size() > 2 ? coords[2] : 0.0)
-                              << std::endl;
-        }
+    const bool log_due = m_last_mission_log_s < 0.0 || (now_s - m_last_mission_log_s) >= m_mission_log_dt_s;
+    const bool trace_due = m_trajectory_trace &&
+                           (m_last_trace_s < 0.0 || (now_s - m_last_trace_s) >= m_trace_dt_s);
+    if ((log_due || trace_due) && m_position) {
+      m_position->retrieveCurrentPosition();
+      const auto coords = m_position->getCoordinates();
+      const uint8_t hops = hopEngine() ? hopEngine()->getHopsFromBase() : UINT8_MAX;
+      const size_t n_neighbors = m_neighbor_manager ? m_neighbor_manager->neighbors().size() : 0;
+      if (log_due) {
+        // help_proxy_rx / help_proxy_tx are -1 until one has been received / sent.
+        SWARM_LOG(INFO, REPOSITION, now_s, now_s - m_last_mission_log_s, m_id, hops, n_neighbors,
+                  coords.x, coords.y, coords.z, m_last_help_proxy_rx_s, m_last_help_proxy_tx_s);
       }
+      if (trace_due) {
+        m_trajectory_trace->append(now_s, m_id, hops, n_neighbors, coords);
+        m_last_trace_s = now_s;
+      }
+    }
+    if (log_due) {
       m_last_mission_log_s = now_s;
     }
   }
@@ -134,9 +226,15 @@ void Ns3Drone::onTick() {
   // Drive motion in lockstep with simulation time.
   // - If mission is active: one potential-field iteration per tick.
   // - If mission is off: apply a default "idle" velocity so drones move and can leave coverage.
+  if (m_neighbor_manager) {
+    m_neighbor_manager->advance(now_s);
+  }
+  if (m_distance_vector) {
+    m_distance_vector->tick(now_s);
+  }
   if (m_flood_manager && m_velocity_actuator && m_neighbor_manager && m_position) {
     m_controller.step(
-      m_flood_manager.get(), 
+      hopEngine(), 
       m_velocity_actuator.get(), 
       m_neighbor_manager.get(), 
       m_position.get()
@@ -147,10 +245,11 @@ void Ns3Drone::onTick() {
   // HELP_PROXY is only emitted when we are not in mission.
   sendPositionUpdate();
 
-  ::ns3::Simulator::Schedule(::ns3::Seconds(m_tick_dt_s), ::ns3::MakeCallback(&Ns3Drone::onTick, this));
+  // One datagram per destination for everything queued this tick (beacon, POS_UPDATE, ...).
+  m_comm.flush();
 }
 
-void Ns3Drone::dispatchPacket(const ::Packet& pkt) {
+void Ns3Drone::dispatchPacket(const ::PacketView& pkt) {
   if (pkt.payload.empty()) {
     return;
   }
@@ -162,7 +261,7 @@ void Ns3Drone::dispatchPacket(const ::Packet& pkt) {
   m_dispatcher.handlePacket(pkt);
 }
 
-void Ns3Drone::handleCorePacket(const ::Packet& pkt) {
+void Ns3Drone::handleCorePacket(const ::PacketView& pkt) {
   if (pkt.payload.size() < 1) {
     return;
   }
@@ -196,11 +295,10 @@ void Ns3Drone::handleCorePacket(const ::Packet& pkt) {
       // This is critical for the flood hop-count calculation to remain accurate.
       if (!help_proxy_sent) {
         m_last_ack_rx_s = ::ns3::Simulator::Now().GetSeconds();
+        markBaseReachable();
       } else {
         // Log when the lost drone receives a relayed ACK
-        std::cout << "[RELAYED_ACK_RX] t=" << ::ns3::Simulator::Now().GetSeconds() 
-                  << "s drone=" << static_cast<int>(m_id)
-                  << " seq=" << ack.seq << std::endl;
+        SWARM_LOG(INFO, RELAYED_ACK_RX, ::ns3::Simulator::Now().GetSeconds(), m_id, ack.seq);
       }
       m_last_acked_seq = ack.seq;
       m_waiting_ack = false;
@@ -246,11 +344,8 @@ void Ns3Drone::handleCorePacket(const ::Packet& pkt) {
       if (m_position) {
         m_position->retrieveCurrentPosition();
         const auto coords = m_position->getCoordinates();
-        std::cout << "[HELP_PROXY RX] t=" << m_last_help_proxy_rx_s << "s drone=" << static_cast<int>(m_id)
-                  << " requester=" << static_cast<int>(msg.requester_id)
-                  << " pos=(" << (coords.size() > 0 ? coords[0] : 0.0)
-                  << "," << (coords.size() > 1 ? coords[1] : 0.0)
-                  << "," << (coords.size() > 2 ? coords[2] : 0.0) << ")" << std::endl;
+        SWARM_LOG(INFO, HELP_PROXY_RX, m_last_help_proxy_rx_s, m_id, msg.requester_id,
+                  coords.x, coords.y, coords.z);
       }
 
       // Enter mission mode to reposition the swarm.
@@ -308,6 +403,12 @@ void Ns3Drone::sendPositionUpdate() {
     return;
   }
 
+  const double speed = m_custom_mobility ? m_custom_mobility->getVelocity().module() : 0.0;
+  const double accel = m_custom_mobility ? m_custom_mobility->getAcceleration().module() : 0.0;
+  if (!m_pos_rate.shouldSend(now_s, speed, accel, m_controller.isMissionActive())) {
+    return;
+  }
+
   m_position->retrieveCurrentPosition();
   const auto coords = m_position->getCoordinates();
 
@@ -318,9 +419,9 @@ void Ns3Drone::sendPositionUpdate() {
   pos.drone_id = m_id;
   pos.base_id = m_base_id;
   pos.seq = ++m_pos_seq;
-  pos.x = coords.size() > 0 ? static_cast<float>(coords[0]) : 0.0f;
-  pos.y = coords.size() > 1 ? static_cast<float>(coords[1]) : 0.0f;
-  pos.z = coords.size() > 2 ? static_cast<float>(coords[2]) : 0.0f;
+  pos.x = static_cast<float>(coords.x);
+  pos.y = static_cast<float>(coords.y);
+  pos.z = static_cast<float>(coords.z);
 
   ::Packet out;
   out.type = ::PacketType::CORE;
@@ -334,21 +435,16 @@ void Ns3Drone::sendPositionUpdate() {
   m_waiting_ack = true;
 }
 
-void Ns3Drone::sendHelpProxy() {
+void Ns3Drone::sendHelpProxy(const char* reason) {
   m_last_help_proxy_tx_s = ::ns3::Simulator::Now().GetSeconds();
 
   if (m_position) {
     m_position->retrieveCurrentPosition();
     const auto coords = m_position->getCoordinates();
-    std::cout << "[HELP_PROXY TX] t=" << m_last_help_proxy_tx_s << "s drone=" << static_cast<int>(m_id)
-              << " reason=ACK_TIMEOUT"
-              << " last_ack=" << m_last_ack_rx_s << "s"
-              << " pos=(" << (coords.size() > 0 ? coords[0] : 0.0)
-              << "," << (coords.size() > 1 ? coords[1] : 0.0)
-              << "," << (coords.size() > 2 ? coords[2] : 0.0) << ")" << std::endl;
+    SWARM_LOG(INFO, HELP_PROXY_TX, m_last_help_proxy_tx_s, m_id, reason, m_last_ack_rx_s,
+              coords.x, coords.y, coords.z);
   } else {
-    std::cout << "[HELP_PROXY TX] t=" << m_last_help_proxy_tx_s << "s drone=" << static_cast<int>(m_id)
-              << " reason=ACK_TIMEOUT" << std::endl;
+    SWARM_LOG(INFO, HELP_PROXY_TX, m_last_help_proxy_tx_s, m_id, reason);
   }
 
   HelpProxyMsg help;
@@ -365,13 +461,56 @@ void Ns3Drone::sendHelpProxy() {
   m_comm.send(out);
 
   help_proxy_sent = true;
+  m_coverage_exit_event.Cancel();
+}
+
+void Ns3Drone::markBaseReachable() {
+  if (!m_has_base || !m_flood_manager) {
+    return;
+  }
+
+  // The base stays reachable until m_ack_timeout_s passes without a direct ACK.
+  m_flood_manager->setBaseReachable(true);
+  if (m_distance_vector) {
+    m_distance_vector->setBaseReachable(true, ::ns3::Simulator::Now().GetSeconds());
+  }
+  m_reachability_timeout.Cancel();
+  m_reachability_timeout = ::ns3::Simulator::Schedule(
+    ::ns3::Seconds(m_ack_timeout_s), ::ns3::MakeCallback(&Ns3Drone::onReachabilityTimeout, this));
+}
+
+void Ns3Drone::onReachabilityTimeout() {
+  if (m_flood_manager) {
+    m_flood_manager->setBaseReachable(false);
+  }
+  if (m_distance_vector) {
+    m_distance_vector->setBaseReachable(false, ::ns3::Simulator::Now().GetSeconds());
+  }
 }
 
-bool Ns3Drone::isBaseReachable() const {
-  if (!m_has_base) {
-    return false;
+void Ns3Drone::armCoverageExit() {
+  m_coverage_exit_event.Cancel();
+  if (!m_coverage_prediction.enabled || help_proxy_sent || !m_has_base || !m_base_position || !m_custom_mobility) {
+    return;
   }
 
   const double now_s = ::ns3::Simulator::Now().GetSeconds();
-  return (now_s - m_last_ack_rx_s) <= m_ack_timeout_s;
-}
\ No newline at end of file
+  const double exit_s = m_custom_mobility->predictExit(
+    m_base_position->getCoordinates(), sim::RadioEnvironment::Get().MaxRangeMeters());
+  if (std::isinf(exit_s)) {
+    return;
+  }
+  const double fire_s = std::max(now_s, exit_s - m_coverage_prediction.lead_s);
+  m_coverage_exit_event = ::ns3::Simulator::Schedule(
+    ::ns3::Seconds(fire_s - now_s), ::ns3::MakeCallback(&Ns3Drone::onCoverageExit, this));
+}
+
+void Ns3Drone::onCoverageExit() {
+  if (help_proxy_sent) {
+    return;
+  }
+  sendHelpProxy("PREDICTED_EXIT");
+  m_waiting_ack = false;
+  // Fired between ticks: send now rather than at the next tick's flush.
+  m_comm.flush();
+}
@@ -11,28 +11,52 @@
 #include "modules/communication/communication_manager.h"
 #include "modules/controller/controller.h"
 #include "modules/dispatch/dispatch_manager.h"
+#include "modules/flood/distance_vector_manager.h"
 #include "modules/flood/flood_manager.h"
+#include "modules/logging/event_log.h"
+#include "modules/logging/trajectory_trace.h"
 #include "modules/neighbor/neighbor_manager.h"
 
+#include "common/adaptive_rate.h"
 #include "common/messages.h"
 #include "common/packet.h"
 
 #include "ns3/core-module.h"
-#include "ns3/constant-position-mobility-model.h"
+#include "ns3/mobility-model.h"
 #include "ns3/internet-module.h"
 
 #include "platform/ns3/custom_mobility/custom_mobility.h"
 #include "platform/ns3/position/ns3_position.h"
-#include "platform/ns3/transport/ns3_socket_transport.h"
+#include "platform/ns3/transport/transport_factory.h"
 #include "platform/ns3/velocity_actuator/ns3_velocity_actuator.h"
 #include "platform/ns3/radio_environment/radio_environment.h"
 
+// Source of the hop estimate fed to the controller.
+enum class HopEngine : uint8_t {
+  FLOOD = 0,            // base-triggered floods (FloodManager)
+  DISTANCE_VECTOR = 1,  // min(neighbor hops) + 1 from beacons (DistanceVectorManager)
+};
+
+// Coverage-exit prediction: the time at which the drone's current motion crosses the base
+// coverage sphere (MaxRangeMeters()) is solved from its kinematic segment, and a single
+// event is armed there and re-armed on every course change. When it fires, HELP_PROXY
+// goes out without waiting for the ACK timeout, which remains the fallback.
+struct CoveragePredictionConfig {
+  bool enabled = false;
+  double lead_s = 0.0;  // act this long before the predicted crossing
+};
+
 // NS-3 bound drone node logic.
 // - While not in mission: periodically unicast PositionUpdateMsg to base and wait for PositionAckMsg.
 // - If ACK is missing for too long: broadcast HelpProxyMsg.
 // - When mission starts: Controller drives motion and NeighborManager broadcasts to neighbors.
 class Ns3Drone {
  public:
+  // Period of the drone tick; motion commands (and radio grid updates) follow it.
+  static constexpr double kTickIntervalS = 0.05;
+  // Silence from the base after which the drone gives up and sends HELP_PROXY.
+  static constexpr double kAckTimeoutS = 1.5;
+
   Ns3Drone(
     uint8_t id,
     ::ns3::Ptr<::ns3::Node> node,
@@ -53,19 +77,60 @@ class Ns3Drone {
   void startMission();
   void stopMission();
 
+  // Schedules the drone's own periodic tick (first at tickPhase(), then every tickInterval()).
   void start();
 
-  void setRepositionLogger(const std::shared_ptr<std::ofstream>& csv);
+  // One tick of drone behavior, without rescheduling; for external drivers such as Ns3Swarm.
+  void tick();
+  double tickInterval() const { return m_tick_dt_s; }
+  double tickPhase() const { return m_tick_phase_s; }
+
+  // Records a trajectory sample every `sample_dt_s` (0: every tick) once a mission has started.
+  void setTrajectoryTrace(const std::shared_ptr<TrajectoryTrace>& trace, double sample_dt_s);
+
+  // Batch the messages of each tick into one datagram per destination (default: on).
+  void setMessageCoalescing(bool enabled);
+
+  void setFloodSuppression(const FloodSuppressionConfig& config);
+  FloodSuppressionStats floodSuppressionStats() const;
+
+  // Merge flood reports emitted within `window_s` into REPORT_AGG frames (0 = off).
+  void setFloodReportAggregation(double window_s);
+
+  void setNeighborAging(const NeighborAgingConfig& config);
+  void setBeaconFormat(const NeighborBeaconConfig& config);
+  void setBeaconPrediction(const NeighborPredictionConfig& config);
+  NeighborBeaconStats beaconStats() const;
+  NeighborAgingStats neighborAgingStats() const;
+
+  // Motion-adaptive rate for both POS_UPDATE and neighbor beacons (default: off, every tick).
+  // The POS_UPDATE keep-alive is capped to a third of the ACK timeout.
+  void setAdaptiveRates(const AdaptiveRateConfig& config);
+  const AdaptiveRateStats& positionUpdateStats() const { return m_pos_rate.stats(); }
+
+  // Both engines are kept up to date; this picks the one the controller reads (default: FLOOD).
+  void setHopEngine(HopEngine engine);
+
+  void setCoveragePrediction(const CoveragePredictionConfig& config);
 
  private:
   void onTick();
-  void dispatchPacket(const ::Packet& pkt);
-  void handleCorePacket(const ::Packet& pkt);
+  void dispatchPacket(const ::PacketView& pkt);
+  void handleCorePacket(const ::PacketView& pkt);
 
   void sendPositionUpdate();
-  void sendHelpProxy();
+  void sendHelpProxy(const char* reason);
+
+  // Reachability is pushed to the FloodManager: set on every direct ACK, cleared by
+  // a single timeout event that each ACK re-arms.
+  void markBaseReachable();
+  void onReachabilityTimeout();
 
-  bool isBaseReachable() const;
+  // (Re)arms the predicted coverage-exit event from the current motion segment.
+  void armCoverageExit();
+  void onCoverageExit();
+
+  FloodManagerInterface* hopEngine() const;
 
   uint8_t m_id;
   ::ns3::Ptr<::ns3::Node> m_node;
@@ -84,6 +149,8 @@ class Ns3Drone {
   CommunicationManager m_comm;
 
   std::unique_ptr<FloodManager> m_flood_manager;
+  std::unique_ptr<DistanceVectorManager> m_distance_vector;
+  HopEngine m_hop_engine = HopEngine::FLOOD;
   std::unique_ptr<NeighborManager> m_neighbor_manager;
   DispatchManager m_dispatcher;
 
@@ -102,17 +169,24 @@ class Ns3Drone {
   double m_last_idle_log_s = -1.0;
   double m_idle_log_dt_s = 2.0;
 
-  std::shared_ptr<std::ofstream> m_reposition_csv;
+  std::shared_ptr<TrajectoryTrace> m_trajectory_trace;
+  double m_trace_dt_s = 0.5;
+  double m_last_trace_s = -1.0;
 
   // Heartbeat/ack tracking (reachability is based on receiving ACKs)
-  double m_tick_dt_s = 0.05;
+  double m_tick_dt_s = kTickIntervalS;
   double m_tick_phase_s = 0.0;
 
-  double m_ack_timeout_s = 1.5;
+  double m_ack_timeout_s = kAckTimeoutS;
   double m_last_ack_rx_s = 0.0;
   bool m_waiting_ack = false;
+  ::ns3::EventId m_reachability_timeout;
+
+  CoveragePredictionConfig m_coverage_prediction;
+  ::ns3::EventId m_coverage_exit_event;
   
   uint16_t m_pos_seq = 0;
   uint16_t m_last_acked_seq = 0;
   double m_last_pos_send_s = 0.0;
+  AdaptiveRate m_pos_rate;
 };
@@ -5,12 +5,7 @@ Ns3Position::Ns3Position(
 ) : mobility(mobility)
 { 
     if (mobility) {
-        const std::vector<double> pos = mobility->getPosition();
-        if (pos.size() >= 3) {
-            x = pos[0];
-            y = pos[1];
-            z = pos[2];
-        }
+        coordinates = mobility->getPosition();
     }
 }
 
@@ -18,33 +13,22 @@ void Ns3Position::retrieveCurrentPosition() {
     if (!mobility) {
         return;
     }
-    const std::vector<double> pos = mobility->getPosition();
-    if (pos.size() >= 3) {
-        x = pos[0];
-        y = pos[1];
-        z = pos[2];
-    }
+    coordinates = mobility->getPosition();
+    velocity = mobility->getVelocity();
 }
 
-std::vector<double> Ns3Position::getCoordinates() const {
-    return {x, y, z};
+Vector3D Ns3Position::getCoordinates() const {
+    return coordinates;
 }
 
 Vector3D Ns3Position::distanceFrom(const PositionInterface* other) const {
-    std::vector<double> my_coords = getCoordinates();
-    std::vector<double> other_coords = other->getCoordinates();
-    return Vector3D(
-        other_coords[0] - my_coords[0],
-        other_coords[1] - my_coords[1],
-        other_coords[2] - my_coords[2]
-    );
+    return other->getCoordinates() - coordinates;
+}
+
+Vector3D Ns3Position::distanceFromCoords(Vector3D other_coords) const {
+    return other_coords - coordinates;
 }
 
-Vector3D Ns3Position::distanceFromCoords(const std::vector<double>& other_coords) const {
-    std::vector<double> my_coords = getCoordinates();
-    return Vector3D(
-        other_coords[0] - my_coords[0],
-        other_coords[1] - my_coords[1],
-        other_coords[2] - my_coords[2]
-    );
-}
\ No newline at end of file
+Vector3D Ns3Position::getVelocity() const {
+    return velocity;
+}
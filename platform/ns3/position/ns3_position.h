@@ -1,5 +1,4 @@
 #pragma once
-#include <vector>
 #include "interfaces/position.h"
 #include "platform/ns3/custom_mobility/custom_mobility.h"
 #include "ns3/core-module.h"
@@ -8,12 +7,12 @@ class Ns3Position : public PositionInterface {
     public: 
         Ns3Position(CustomMobility* mobility);
         void retrieveCurrentPosition() override;
-        std::vector<double> getCoordinates() const override;
+        Vector3D getCoordinates() const override;
         Vector3D distanceFrom(const PositionInterface* other) const override;
-        Vector3D distanceFromCoords(const std::vector<double>& other_coords) const override;
+        Vector3D distanceFromCoords(Vector3D other_coords) const override;
+        Vector3D getVelocity() const override;
     private: 
         CustomMobility* mobility;
-        double x = 0.0;
-        double y = 0.0;
-        double z = 0.0;
+        Vector3D coordinates{0.0, 0.0, 0.0};
+        Vector3D velocity{0.0, 0.0, 0.0};
 };
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "ns3/mobility-model.h"
 #include "ns3/network-module.h"
 
 namespace sim {
@@ -10,4 +11,12 @@ struct RadioEndpoint {
   ::ns3::Ptr<::ns3::Socket> socket;
 };
 
+// Entry of the IP-indexed peer table: the endpoint plus the node and mobility model
+// the receive path needs for its range check, resolved once instead of per packet.
+struct RadioPeer {
+  RadioEndpoint endpoint;
+  ::ns3::Ptr<::ns3::Node> node;
+  ::ns3::Ptr<::ns3::MobilityModel> mobility;
+};
+
 }  // namespace sim
@@ -1,5 +1,8 @@
 #include "platform/ns3/radio_environment/radio_environment.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace sim {
 
 RadioEnvironment& RadioEnvironment::Get() {
@@ -22,6 +25,20 @@ void RadioEnvironment::InitIfNeeded() {
     return;
   }
 
+  // Compute directed broadcast (e.g. 10.1.1.255 for /24).
+  ::ns3::Ipv4Address base(m_cfg.networkBase.c_str());
+  ::ns3::Ipv4Mask mask(m_cfg.networkMask.c_str());
+  m_broadcast = ::ns3::Ipv4Address(base.Get() | ~mask.Get());
+  m_network_base = base.Get() & mask.Get();
+  m_network_mask = mask.Get();
+
+  m_initialized = true;
+
+  if (m_cfg.channel == RadioChannelModel::IDEAL) {
+    // Ideal channel: no PHY/MAC/IP stack is simulated (see Ns3IdealTransport).
+    return;
+  }
+
   // Wi-Fi ad-hoc approximates a simple swarm radio reasonably well.
   // Using 802.11b as a conservative baseline (robust / low data rate).
     m_wifi.SetStandard(::ns3::WIFI_STANDARD_80211b);
@@ -44,13 +61,6 @@ void RadioEnvironment::InitIfNeeded() {
   m_mac.SetType("ns3::AdhocWifiMac");
 
   m_ipv4.SetBase(m_cfg.networkBase.c_str(), m_cfg.networkMask.c_str());
-
-  // Compute directed broadcast (e.g. 10.1.1.255 for /24).
-  ::ns3::Ipv4Address base(m_cfg.networkBase.c_str());
-  ::ns3::Ipv4Mask mask(m_cfg.networkMask.c_str());
-  m_broadcast = ::ns3::Ipv4Address(base.Get() | ~mask.Get());
-
-  m_initialized = true;
 }
 
 RadioEndpoint RadioEnvironment::Install(::ns3::Ptr<::ns3::Node> node) {
@@ -67,54 +77,202 @@ RadioEndpoint RadioEnvironment::Install(::ns3::Ptr<::ns3::Node> node) {
     return existing->second;
   }
 
-  // Ensure the Internet stack is present.
-  if (!node->GetObject<::ns3::Ipv4>()) {
-    m_internet.Install(node);
-  }
+  RadioEndpoint ep;
+  if (m_cfg.channel == RadioChannelModel::IDEAL) {
+    // No devices: the ideal channel only needs an address to index the node by. Hosts
+    // are 1 .. ~mask - 1; the last address is the directed broadcast.
+    if (m_next_ideal_host + 1 >= ~m_network_mask) {
+      NS_FATAL_ERROR("RadioEnvironment: subnet " << m_cfg.networkBase << "/" << m_cfg.networkMask
+                     << " has no host address left for node " << nodeId);
+    }
+    ep.ip = ::ns3::Ipv4Address(m_network_base + (++m_next_ideal_host));
+  } else {
+    // Ensure the Internet stack is present.
+    if (!node->GetObject<::ns3::Ipv4>()) {
+      m_internet.Install(node);
+    }
 
-  ::ns3::NodeContainer one;
-  one.Add(node);
+    ::ns3::NodeContainer one;
+    one.Add(node);
 
-  ::ns3::NetDeviceContainer devices = m_wifi.Install(m_phy, m_mac, one);
-  ::ns3::Ptr<::ns3::NetDevice> dev = devices.Get(0);
+    ::ns3::NetDeviceContainer devices = m_wifi.Install(m_phy, m_mac, one);
+    ::ns3::Ptr<::ns3::NetDevice> dev = devices.Get(0);
 
-  ::ns3::TrafficControlHelper tch;
-  tch.SetRootQueueDisc("ns3::PfifoFastQueueDisc");
-  tch.Install(devices);
+    ::ns3::TrafficControlHelper tch;
+    tch.SetRootQueueDisc("ns3::PfifoFastQueueDisc");
+    tch.Install(devices);
 
-  ::ns3::Ipv4InterfaceContainer ifaces = m_ipv4.Assign(devices);
-  ::ns3::Ipv4Address ip = ifaces.GetAddress(0);
+    ::ns3::Ipv4InterfaceContainer ifaces = m_ipv4.Assign(devices);
+    ::ns3::Ipv4Address ip = ifaces.GetAddress(0);
 
-  ::ns3::Ptr<::ns3::Socket> sock = ::ns3::Socket::CreateSocket(node, ::ns3::UdpSocketFactory::GetTypeId());
-  sock->Bind(::ns3::InetSocketAddress(::ns3::Ipv4Address::GetAny(), m_cfg.port));
-  sock->SetAllowBroadcast(true);
+    ::ns3::Ptr<::ns3::Socket> sock = ::ns3::Socket::CreateSocket(node, ::ns3::UdpSocketFactory::GetTypeId());
+    sock->Bind(::ns3::InetSocketAddress(::ns3::Ipv4Address::GetAny(), m_cfg.port));
+    sock->SetAllowBroadcast(true);
 
-  RadioEndpoint ep;
-  ep.device = dev;
-  ep.ip = ip;
-  ep.socket = sock;
+    ep.device = dev;
+    ep.ip = ip;
+    ep.socket = sock;
+  }
 
   m_endpoints.emplace(nodeId, ep);
+
+  const int64_t slot = PeerSlot(ep.ip);
+  if (slot >= 0) {
+    if (static_cast<size_t>(slot) >= m_peers_by_slot.size()) {
+      m_peers_by_slot.resize(static_cast<size_t>(slot) + 1);
+      m_grid_slots.resize(static_cast<size_t>(slot) + 1);
+    }
+    RadioPeer& peer = m_peers_by_slot[static_cast<size_t>(slot)];
+    peer.endpoint = ep;
+    peer.node = node;
+    peer.mobility = node->GetObject<::ns3::MobilityModel>();
+
+    if (peer.mobility) {
+      PlaceSlot(static_cast<size_t>(slot), peer.mobility->GetPosition());
+    } else {
+      m_unplaced_slots.push_back(static_cast<size_t>(slot));
+    }
+  }
+  m_all_ips.push_back(ep.ip);
+
   return ep;
 }
 
-std::vector<::ns3::Ipv4Address> RadioEnvironment::AllIps() const {
-  std::vector<::ns3::Ipv4Address> out;
-  out.reserve(m_endpoints.size());
-  for (const auto& kv : m_endpoints) {
-    out.push_back(kv.second.ip);
+int64_t RadioEnvironment::PeerSlot(::ns3::Ipv4Address ip) const {
+  const uint32_t addr = ip.Get();
+  if ((addr & m_network_mask) != m_network_base) {
+    return -1;
+  }
+  return static_cast<int64_t>(addr & ~m_network_mask);
+}
+
+const RadioPeer* RadioEnvironment::FindPeerByIp(::ns3::Ipv4Address ip) {
+  const int64_t slot = PeerSlot(ip);
+  if (slot < 0 || static_cast<size_t>(slot) >= m_peers_by_slot.size()) {
+    return nullptr;
+  }
+
+  RadioPeer& peer = m_peers_by_slot[static_cast<size_t>(slot)];
+  if (!peer.node) {
+    return nullptr;
+  }
+  if (!peer.mobility) {
+    peer.mobility = peer.node->GetObject<::ns3::MobilityModel>();
   }
-  return out;
+  return &peer;
 }
 
 ::ns3::Ptr<::ns3::Node> RadioEnvironment::FindNodeByIp(::ns3::Ipv4Address ip) const {
-  for (const auto& kv : m_endpoints) {
-    const auto& ep = kv.second;
-    if (ep.ip == ip) {
-      return ep.socket ? ep.socket->GetNode() : nullptr;
+  const int64_t slot = PeerSlot(ip);
+  if (slot < 0 || static_cast<size_t>(slot) >= m_peers_by_slot.size()) {
+    return nullptr;
+  }
+  return m_peers_by_slot[static_cast<size_t>(slot)].node;
+}
+
+int64_t RadioEnvironment::CellCoord(double v) const {
+  const double range = m_cfg.maxRangeMeters > 0.0 ? m_cfg.maxRangeMeters : 1.0;
+  const double cell = range + std::max(0.0, m_cfg.gridDriftMarginMeters);
+  return static_cast<int64_t>(std::floor(v / cell));
+}
+
+int64_t RadioEnvironment::CellKey(int64_t cx, int64_t cy, int64_t cz) const {
+  // 21 bits per axis: about +-1e6 cells, far beyond any scenario area.
+  constexpr int64_t kMask = (int64_t{1} << 21) - 1;
+  return ((cx & kMask) << 42) | ((cy & kMask) << 21) | (cz & kMask);
+}
+
+void RadioEnvironment::PlaceSlot(size_t slot, const ::ns3::Vector& pos) {
+  GridSlot& g = m_grid_slots[slot];
+  const int64_t cell = CellKey(CellCoord(pos.x), CellCoord(pos.y), CellCoord(pos.z));
+  if (g.placed && g.cell == cell) {
+    return;
+  }
+
+  if (g.placed) {
+    auto& members = m_grid_cells[g.cell];
+    const auto it = std::find(members.begin(), members.end(), slot);
+    if (it != members.end()) {
+      *it = members.back();
+      members.pop_back();
+    }
+  } else {
+    const auto it = std::find(m_unplaced_slots.begin(), m_unplaced_slots.end(), slot);
+    if (it != m_unplaced_slots.end()) {
+      *it = m_unplaced_slots.back();
+      m_unplaced_slots.pop_back();
     }
   }
-  return nullptr;
+
+  m_grid_cells[cell].push_back(slot);
+  g.placed = true;
+  g.cell = cell;
+}
+
+void RadioEnvironment::UpdatePosition(::ns3::Ptr<::ns3::Node> node, const ::ns3::Vector& pos) {
+  if (!node) {
+    return;
+  }
+  const auto it = m_endpoints.find(node->GetId());
+  if (it == m_endpoints.end()) {
+    return;
+  }
+  const int64_t slot = PeerSlot(it->second.ip);
+  if (slot < 0 || static_cast<size_t>(slot) >= m_grid_slots.size()) {
+    return;
+  }
+  PlaceSlot(static_cast<size_t>(slot), pos);
+}
+
+void RadioEnvironment::PeersInRange(::ns3::Ipv4Address self, std::vector<const RadioPeer*>& out) {
+  out.clear();
+
+  const RadioPeer* sender = FindPeerByIp(self);
+  if (!sender || !sender->mobility) {
+    // Unknown sender position: every peer is a candidate.
+    for (const auto& peer : m_peers_by_slot) {
+      if (peer.node && peer.endpoint.ip != self) {
+        out.push_back(&peer);
+      }
+    }
+    return;
+  }
+
+  const ::ns3::Vector here = sender->mobility->GetPosition();
+  const double range = m_cfg.maxRangeMeters;
+  const auto consider = [&](size_t slot) {
+    RadioPeer& peer = m_peers_by_slot[slot];
+    if (!peer.node || &peer == sender) {
+      return;
+    }
+    if (!peer.mobility) {
+      peer.mobility = peer.node->GetObject<::ns3::MobilityModel>();
+    }
+    if (peer.mobility && ::ns3::CalculateDistance(here, peer.mobility->GetPosition()) > range) {
+      return;
+    }
+    out.push_back(&peer);
+  };
+
+  const int64_t cx = CellCoord(here.x);
+  const int64_t cy = CellCoord(here.y);
+  const int64_t cz = CellCoord(here.z);
+  for (int64_t dx = -1; dx <= 1; ++dx) {
+    for (int64_t dy = -1; dy <= 1; ++dy) {
+      for (int64_t dz = -1; dz <= 1; ++dz) {
+        const auto cell = m_grid_cells.find(CellKey(cx + dx, cy + dy, cz + dz));
+        if (cell == m_grid_cells.end()) {
+          continue;
+        }
+        for (const size_t slot : cell->second) {
+          consider(slot);
+        }
+      }
+    }
+  }
+  for (const size_t slot : m_unplaced_slots) {
+    consider(slot);
+  }
 }
 
 }  // namespace sim
@@ -34,21 +34,48 @@ class RadioEnvironment {
   void Configure(const RadioEnvironmentConfig& cfg);
 
   // Installs Wi-Fi ad-hoc + Internet stack + IPv4 address + UDP socket on `node`.
+  // With RadioChannelModel::IDEAL only an address is assigned (no device, no socket).
   // Safe to call multiple times for the same node (returns the cached endpoint).
   RadioEndpoint Install(::ns3::Ptr<::ns3::Node> node);
 
   uint16_t Port() const { return m_cfg.port; }
   double MaxRangeMeters() const { return m_cfg.maxRangeMeters; }
+  bool NativeBroadcast() const { return m_cfg.nativeBroadcast; }
+  const RadioEnvironmentConfig& Config() const { return m_cfg; }
   ::ns3::Ipv4Address BroadcastAddress() const { return m_broadcast; }
-  std::vector<::ns3::Ipv4Address> AllIps() const;
+
+  // IPs of every installed node, in install order. Prebuilt; returned by reference.
+  const std::vector<::ns3::Ipv4Address>& AllIps() const { return m_all_ips; }
+
+  // O(1) lookup of an installed peer by its assigned IP (returns nullptr if unknown).
+  // The mobility model is cached on first use, since nodes may aggregate it after Install.
+  const RadioPeer* FindPeerByIp(::ns3::Ipv4Address ip);
 
   // Best-effort lookup of a node by its assigned IP (returns nullptr if unknown).
   ::ns3::Ptr<::ns3::Node> FindNodeByIp(::ns3::Ipv4Address ip) const;
 
+  // Moves `node` to `pos` in the spatial grid. Called on every velocity command and
+  // explicit position change (see CustomMobility), so a cell can lag the analytic
+  // position by one tick of motion (covered by gridDriftMarginMeters); unknown or
+  // not-yet-installed nodes are ignored.
+  void UpdatePosition(::ns3::Ptr<::ns3::Node> node, const ::ns3::Vector& pos);
+
+  // Collects every other installed peer within MaxRangeMeters() of `self` into `out`
+  // (cleared first). Only the 27 grid cells around the sender are visited; peers whose
+  // position has never been reported are always included.
+  void PeersInRange(::ns3::Ipv4Address self, std::vector<const RadioPeer*>& out);
+
  private:
   RadioEnvironment();
   void InitIfNeeded();
 
+  // Dense slot of `ip` inside the configured subnet, or -1 if it is outside.
+  int64_t PeerSlot(::ns3::Ipv4Address ip) const;
+
+  int64_t CellKey(int64_t cx, int64_t cy, int64_t cz) const;
+  int64_t CellCoord(double v) const;
+  void PlaceSlot(size_t slot, const ::ns3::Vector& pos);
+
   RadioEnvironmentConfig m_cfg;
   bool m_initialized = false;
 
@@ -58,8 +85,26 @@ class RadioEnvironment {
   ::ns3::InternetStackHelper m_internet;
   ::ns3::Ipv4AddressHelper m_ipv4;
   ::ns3::Ipv4Address m_broadcast;
+  uint32_t m_network_base = 0;
+  uint32_t m_network_mask = 0;
+  uint32_t m_next_ideal_host = 0;
 
   std::unordered_map<uint32_t, RadioEndpoint> m_endpoints;
+
+  // Indexed by host offset inside the subnet (see PeerSlot); empty slots have no node.
+  std::vector<RadioPeer> m_peers_by_slot;
+  std::vector<::ns3::Ipv4Address> m_all_ips;
+
+  // Uniform spatial hash with cells as wide as the coverage radius plus the drift margin:
+  // every receiver in range of a sender, at the position it last reported, lies in one of
+  // the 27 cells around the sender's cell.
+  struct GridSlot {
+    bool placed = false;
+    int64_t cell = 0;
+  };
+  std::vector<GridSlot> m_grid_slots;  // parallel to m_peers_by_slot
+  std::unordered_map<int64_t, std::vector<size_t>> m_grid_cells;
+  std::vector<size_t> m_unplaced_slots;
 };
 
 }  // namespace sim
@@ -5,16 +5,43 @@
 
 namespace sim {
 
+enum class RadioChannelModel : uint8_t {
+  // Full 802.11b ad-hoc PHY/MAC + Internet stack + UDP socket per node.
+  WIFI = 0,
+  // Direct scheduler delivery with range cutoff, delay, loss and airtime (Ns3IdealTransport).
+  IDEAL = 1,
+};
+
 struct RadioEnvironmentConfig {
   // Simple “coverage area” model: beyond this distance, frames are not received.
   double maxRangeMeters = 30.0;
 
+  // Farthest a node can move between two UpdatePosition() calls (e.g. max speed times the
+  // update period). Spatial grid cells are widened by it so a peer whose cell is stale by
+  // up to this much is still found by the 27-cell search.
+  double gridDriftMarginMeters = 0.0;
+
   // IPv4 subnet used for all nodes that install this radio.
   std::string networkBase = "10.1.1.0";
   std::string networkMask = "255.255.255.0";
 
   // UDP port used for both unicast and broadcast.
   uint16_t port = 9999;
+
+  // Send swarm broadcasts as a single frame to the subnet-directed broadcast address.
+  // When false, broadcast is emulated by a unicast fan-out to every installed peer
+  // (one MAC frame per peer; kept for comparison runs).
+  bool nativeBroadcast = true;
+
+  RadioChannelModel channel = RadioChannelModel::WIFI;
+
+  // Ideal channel parameters (ignored with RadioChannelModel::WIFI).
+  double idealPropagationDelayS = 1e-6;
+  double idealLossProbability = 0.0;
+  double idealDataRateBps = 1e6;
+  // Per-frame bytes added to the payload for airtime: PLCP preamble/header at 1 Mbps
+  // plus MAC, LLC, IPv4 and UDP headers, roughly as in the 802.11b setup.
+  uint32_t idealFrameOverheadBytes = 88;
 };
 
 }  // namespace sim
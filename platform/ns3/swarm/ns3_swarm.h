@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "ns3/core-module.h"
+
+#include "platform/ns3/drone/ns3_drone.h"
+
+// Owns the swarm's drones and drives their ticks.
+//
+// Batched (default): drones are grouped into a small calendar of phase buckets, one per
+// distinct tickPhase() modulo the tick interval, over one contiguous array of tick entries
+// (drone pointer, first tick time) ordered by phase. The drones themselves stay separately
+// allocated, as their scheduled callbacks capture `this`. A single scheduler event walks
+// the buckets, ticking every drone of a bucket in a tight loop and then scheduling the
+// next bucket, so the scheduler holds one pending tick event however large the swarm is,
+// and each drone still ticks at exactly its own phase.
+// Unbatched, or if the drones' tick intervals differ: every drone schedules its own tick,
+// as with Ns3Drone::start().
+class Ns3Swarm {
+ public:
+  Ns3Drone& addDrone(std::unique_ptr<Ns3Drone> drone);
+  const std::vector<std::unique_ptr<Ns3Drone>>& drones() const { return m_drones; }
+
+  void setBatchedTick(bool enabled) { m_batched = enabled; }
+
+  // Starts ticking every added drone.
+  void start();
+
+ private:
+  struct PhaseBucket {
+    int64_t offset_ns = 0;  // phase within the tick interval
+    size_t begin = 0;       // range in m_tick_order
+    size_t end = 0;
+  };
+
+  struct TickEntry {
+    Ns3Drone* drone = nullptr;
+    double first_tick_s = 0.0;  // drones do not tick before their own phase
+  };
+
+  void onBucket();
+
+  std::vector<std::unique_ptr<Ns3Drone>> m_drones;
+  bool m_batched = true;
+
+  std::vector<TickEntry> m_tick_order;
+  std::vector<PhaseBucket> m_buckets;
+  size_t m_next_bucket = 0;
+  int64_t m_interval_ns = 0;
+};
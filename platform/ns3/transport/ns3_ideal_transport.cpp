@@ -0,0 +1,122 @@
+#include "platform/ns3/transport/ns3_ideal_transport.h"
+
+#include <algorithm>
+
+namespace sim {
+
+std::unordered_map<uint32_t, Ns3IdealTransport*> Ns3IdealTransport::s_by_ip;
+
+Ns3IdealTransport::Ns3IdealTransport(::ns3::Ptr<::ns3::Node> node) {
+  m_ep = sim::RadioEnvironment::Get().Install(node);
+  m_loss_rv = ::ns3::CreateObject<::ns3::UniformRandomVariable>();
+  s_by_ip[m_ep.ip.Get()] = this;
+}
+
+Ns3IdealTransport::~Ns3IdealTransport() {
+  const auto it = s_by_ip.find(m_ep.ip.Get());
+  if (it != s_by_ip.end() && it->second == this) {
+    s_by_ip.erase(it);
+  }
+}
+
+void Ns3IdealTransport::RegisterPeer(uint8_t id, uint32_t address) {
+  m_id_to_ip[id] = ::ns3::Ipv4Address(address);
+}
+
+void Ns3IdealTransport::SetRxCallback(RxCallback cb) {
+  m_rx_cb = std::move(cb);
+}
+
+void Ns3IdealTransport::SendUnicast(uint8_t dst_id, const Bytes& bytes) {
+  if (bytes.empty()) {
+    return;
+  }
+
+  auto it = m_id_to_ip.find(dst_id);
+  if (it == m_id_to_ip.end()) {
+    return;
+  }
+
+  auto& env = sim::RadioEnvironment::Get();
+  const RadioPeer* self = env.FindPeerByIp(m_ep.ip);
+  const RadioPeer* dst = env.FindPeerByIp(it->second);
+  if (!dst) {
+    return;
+  }
+
+  // The frame occupies the air whether or not anyone can hear it.
+  const ::ns3::Time delay = ReserveAirtime(bytes.size());
+  if (self && self->mobility && dst->mobility) {
+    const double dist = ::ns3::CalculateDistance(self->mobility->GetPosition(), dst->mobility->GetPosition());
+    if (dist > env.MaxRangeMeters()) {
+      return;
+    }
+  }
+
+  Transmit(*dst, std::make_shared<const Bytes>(bytes), delay);
+}
+
+void Ns3IdealTransport::SendBroadcast(const Bytes& bytes) {
+  if (bytes.empty()) {
+    return;
+  }
+
+  auto& env = sim::RadioEnvironment::Get();
+  env.PeersInRange(m_ep.ip, m_targets);
+  if (m_targets.empty()) {
+    return;
+  }
+
+  // One frame, one airtime slot; receivers share the payload buffer.
+  const ::ns3::Time delay = ReserveAirtime(bytes.size());
+  const auto shared = std::make_shared<const Bytes>(bytes);
+  for (const RadioPeer* peer : m_targets) {
+    Transmit(*peer, shared, delay);
+  }
+}
+
+::ns3::Time Ns3IdealTransport::ReserveAirtime(size_t payload_size) {
+  const auto& cfg = sim::RadioEnvironment::Get().Config();
+  const ::ns3::Time now = ::ns3::Simulator::Now();
+  const ::ns3::Time start = std::max(now, m_tx_free_at);
+
+  const double bits = 8.0 * static_cast<double>(payload_size + cfg.idealFrameOverheadBytes);
+  const double airtime_s = cfg.idealDataRateBps > 0.0 ? bits / cfg.idealDataRateBps : 0.0;
+  m_tx_free_at = start + ::ns3::Seconds(airtime_s);
+
+  return m_tx_free_at - now;
+}
+
+void Ns3IdealTransport::Transmit(
+    const RadioPeer& peer, const std::shared_ptr<const Bytes>& bytes, ::ns3::Time delay) {
+  if (Dropped()) {
+    return;
+  }
+
+  const auto& cfg = sim::RadioEnvironment::Get().Config();
+  const uint32_t dst_ip = peer.endpoint.ip.Get();
+  const uint32_t context = peer.node ? peer.node->GetId() : 0;
+  ::ns3::Simulator::ScheduleWithContext(
+      context, delay + ::ns3::Seconds(cfg.idealPropagationDelayS), &Ns3IdealTransport::Deliver, dst_ip, bytes);
+}
+
+bool Ns3IdealTransport::Dropped() {
+  const double p = sim::RadioEnvironment::Get().Config().idealLossProbability;
+  if (p <= 0.0) {
+    return false;
+  }
+  return m_loss_rv->GetValue(0.0, 1.0) < p;
+}
+
+void Ns3IdealTransport::Deliver(uint32_t dst_ip, std::shared_ptr<const Bytes> bytes) {
+  const auto it = s_by_ip.find(dst_ip);
+  if (it == s_by_ip.end()) {
+    return;
+  }
+  Ns3IdealTransport* dst = it->second;
+  if (dst->m_rx_cb) {
+    dst->m_rx_cb(BytesView(*bytes));
+  }
+}
+
+}  // namespace sim
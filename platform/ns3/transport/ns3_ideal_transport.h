@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/random-variable-stream.h"
+
+#include "interfaces/transport.h"
+#include "platform/ns3/radio_environment/radio_endpoint.h"
+#include "platform/ns3/radio_environment/radio_environment.h"
+
+namespace sim {
+
+// "Ideal range channel" transport for large-swarm runs.
+// Payloads are handed to the receivers' transports through Simulator events instead of
+// going through a Wi-Fi PHY/MAC + IP + UDP stack. Models, from RadioEnvironmentConfig:
+// - range cutoff (MaxRangeMeters, evaluated at transmit time)
+// - constant propagation delay
+// - independent per-receiver loss probability
+// - per-node airtime serialization: a node's frames go out back to back at the data rate
+class Ns3IdealTransport final : public ::Transport {
+ public:
+  explicit Ns3IdealTransport(::ns3::Ptr<::ns3::Node> node);
+  ~Ns3IdealTransport() override;
+
+  void RegisterPeer(uint8_t id, uint32_t address) override;
+  void SendUnicast(uint8_t dst_id, const Bytes& bytes) override;
+  void SendBroadcast(const Bytes& bytes) override;
+  void SetRxCallback(RxCallback cb) override;
+
+  ::ns3::Ipv4Address SelfIp() const { return m_ep.ip; }
+
+ private:
+  // Reserves airtime for one frame and returns the delay until it has fully left the radio.
+  ::ns3::Time ReserveAirtime(size_t payload_size);
+  void Transmit(const RadioPeer& peer, const std::shared_ptr<const Bytes>& bytes, ::ns3::Time delay);
+  bool Dropped();
+
+  static void Deliver(uint32_t dst_ip, std::shared_ptr<const Bytes> bytes);
+
+  RadioEndpoint m_ep;
+  RxCallback m_rx_cb;
+  std::unordered_map<uint8_t, ::ns3::Ipv4Address> m_id_to_ip;
+
+  ::ns3::Ptr<::ns3::UniformRandomVariable> m_loss_rv;
+  ::ns3::Time m_tx_free_at;
+
+  // Scratch list reused by SendBroadcast to avoid a per-send allocation.
+  std::vector<const RadioPeer*> m_targets;
+
+  // Live transports by IPv4 address, so deliveries scheduled to a destroyed node are dropped.
+  static std::unordered_map<uint32_t, Ns3IdealTransport*> s_by_ip;
+};
+
+}  // namespace sim
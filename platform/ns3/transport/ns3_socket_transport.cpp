@@ -38,14 +38,26 @@ void Ns3SocketTransport::SendBroadcast(const Bytes& bytes) {
     return;
   }
 
-  // Emulate swarm broadcast by unicast fan-out to all known peers.
-  const auto peers = sim::RadioEnvironment::Get().AllIps();
-  for (const auto& ip : peers) {
-    if (ip == m_ep.ip) {
-      continue;
-    }
+  auto& env = sim::RadioEnvironment::Get();
+
+  // Spatial-grid pruning: only peers currently within coverage are worth a frame.
+  env.PeersInRange(m_ep.ip, m_targets);
+  if (m_targets.empty()) {
+    return;
+  }
+
+  if (env.NativeBroadcast()) {
+    // One frame on the air: every radio in range picks it up, range is still checked on receive.
     ::ns3::Ptr<::ns3::Packet> p = ::ns3::Create<::ns3::Packet>(bytes.data(), static_cast<uint32_t>(bytes.size()));
-    ::ns3::InetSocketAddress addr(ip, sim::RadioEnvironment::Get().Port());
+    ::ns3::InetSocketAddress addr(env.BroadcastAddress(), env.Port());
+    m_ep.socket->SendTo(p, 0, addr);
+    return;
+  }
+
+  // Emulate swarm broadcast by unicast fan-out to the peers in range.
+  for (const RadioPeer* peer : m_targets) {
+    ::ns3::Ptr<::ns3::Packet> p = ::ns3::Create<::ns3::Packet>(bytes.data(), static_cast<uint32_t>(bytes.size()));
+    ::ns3::InetSocketAddress addr(peer->endpoint.ip, env.Port());
     m_ep.socket->SendTo(p, 0, addr);
   }
 }
@@ -64,29 +76,33 @@ void Ns3SocketTransport::OnSocketRx(::ns3::Ptr<::ns3::Socket> sock) {
     }
 
     // Enforce coverage radius at receive-time.
-    // This is important because our broadcast is implemented as a unicast fan-out.
+    // This is important when broadcast is emulated as a unicast fan-out, and keeps the
+    // coverage area strict for directed broadcasts as well.
     if (::ns3::InetSocketAddress::IsMatchingType(from)) {
       const auto fromInet = ::ns3::InetSocketAddress::ConvertFrom(from);
       const auto fromIp = fromInet.GetIpv4();
+      if (fromIp == m_ep.ip) {
+        // Never hand our own broadcast back to the upper layers.
+        continue;
+      }
 
-      const auto env = sim::RadioEnvironment::Get();
-      ::ns3::Ptr<::ns3::Node> srcNode = env.FindNodeByIp(fromIp);
-      ::ns3::Ptr<::ns3::Node> dstNode = sock->GetNode();
-      if (srcNode && dstNode) {
-        auto srcMob = srcNode->GetObject<::ns3::MobilityModel>();
-        auto dstMob = dstNode->GetObject<::ns3::MobilityModel>();
-        if (srcMob && dstMob) {
-          const double dist = ::ns3::CalculateDistance(srcMob->GetPosition(), dstMob->GetPosition());
-          if (dist > env.MaxRangeMeters()) {
-            continue;
-          }
+      auto& env = sim::RadioEnvironment::Get();
+      const RadioPeer* src = env.FindPeerByIp(fromIp);
+      const RadioPeer* dst = env.FindPeerByIp(m_ep.ip);
+      if (src && dst && src->mobility && dst->mobility) {
+        const double dist = ::ns3::CalculateDistance(src->mobility->GetPosition(), dst->mobility->GetPosition());
+        if (dist > env.MaxRangeMeters()) {
+          continue;
         }
       }
     }
 
-    Bytes bytes(size);
-    p->CopyData(bytes.data(), size);
-    m_rx_cb(bytes);
+    // Single copy out of the ns-3 buffer into a receive buffer reused across datagrams.
+    if (m_rx_buffer.size() < size) {
+      m_rx_buffer.resize(size);
+    }
+    p->CopyData(m_rx_buffer.data(), size);
+    m_rx_cb(BytesView(m_rx_buffer.data(), size));
   }
 }
 
@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "ns3/network-module.h"
 #include "ns3/udp-socket-factory.h"
@@ -14,7 +15,8 @@
 namespace sim {
 
 // NS-3 UDP socket transport.
-// Owns socket recv callback and implements unicast + broadcast fan-out.
+// Owns socket recv callback and implements unicast + broadcast (directed broadcast frame,
+// or unicast fan-out when RadioEnvironmentConfig::nativeBroadcast is off).
 class Ns3SocketTransport final : public ::Transport {
  public:
   explicit Ns3SocketTransport(::ns3::Ptr<::ns3::Node> node);
@@ -31,7 +33,11 @@ class Ns3SocketTransport final : public ::Transport {
 
   RadioEndpoint m_ep;
   RxCallback m_rx_cb;
+  Bytes m_rx_buffer;
   std::unordered_map<uint8_t, ::ns3::Ipv4Address> m_id_to_ip;
+
+  // Scratch list reused by SendBroadcast to avoid a per-send allocation.
+  std::vector<const RadioPeer*> m_targets;
 };
 
 }  // namespace sim
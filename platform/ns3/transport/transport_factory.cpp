@@ -0,0 +1,16 @@
+#include "platform/ns3/transport/transport_factory.h"
+
+#include "platform/ns3/radio_environment/radio_environment.h"
+#include "platform/ns3/transport/ns3_ideal_transport.h"
+#include "platform/ns3/transport/ns3_socket_transport.h"
+
+namespace sim {
+
+std::unique_ptr<::Transport> CreateTransport(::ns3::Ptr<::ns3::Node> node) {
+  if (sim::RadioEnvironment::Get().Config().channel == RadioChannelModel::IDEAL) {
+    return std::make_unique<Ns3IdealTransport>(node);
+  }
+  return std::make_unique<Ns3SocketTransport>(node);
+}
+
+}  // namespace sim
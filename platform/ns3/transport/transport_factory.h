@@ -0,0 +1,15 @@
+#pragma once
+
+#include <memory>
+
+#include "ns3/network-module.h"
+
+#include "interfaces/transport.h"
+
+namespace sim {
+
+// Creates the transport matching RadioEnvironment's configured channel model:
+// Ns3SocketTransport for Wi-Fi, Ns3IdealTransport for the ideal range channel.
+std::unique_ptr<::Transport> CreateTransport(::ns3::Ptr<::ns3::Node> node);
+
+}  // namespace sim